@@ -23,10 +23,22 @@
 
 #include "LCD.h"
 #include "mbed.h"
+#include <string.h>
 
-LCD::LCD(PinName rs, PinName en, PinName d4, PinName d5, PinName d6, PinName d7, lcd_t type) : reset(rs), enable(en), data(d4, d5, d6, d7)
+LCD::LCD(PinName rs, PinName en, PinName d4, PinName d5, PinName d6, PinName d7, lcd_t type, PinName rw) : reset(rs), enable(en), readwrite(rw), data(d4, d5, d6, d7)
 {
     this->type = type;
+    data.output();
+
+    // the busy flag only becomes valid once in 4-bit mode, see below
+    busyflag = false;
+    if (rw != NC)
+    {
+        readwrite = 0;
+    }
+    _address = LCD_UNKNOWN_ADDRESS;
+    displaycontrol = LCD_DISPLAY_ON | LCD_CURSOR_OFF | LCD_BLINK_OFF; // as per 0x0C below
+    displaymode = LCD_ENTRY_LEFT | LCD_ENTRY_SHIFT_DECREMENT; // as per 0x06 below
 
     ThisThread::sleep_for(15); // Wait 15ms to ensure powered up
 
@@ -38,6 +50,7 @@ LCD::LCD(PinName rs, PinName en, PinName d4, PinName d5, PinName d6, PinName d7,
     }
 
     writeCommand(LCD_4BIT_MODE); // set 4bit mode
+    busyflag = (rw != NC);
     writeCommand(0x28); // function set 001 BW N F - -
     writeCommand(0x0C);
     writeCommand(0x06); // cursor direction and display shift : 0000 01 CD S (CD 0-left, 1-right S(hift) 0-no, 1-yes
@@ -47,15 +60,46 @@ LCD::LCD(PinName rs, PinName en, PinName d4, PinName d5, PinName d6, PinName d7,
 
 void LCD::character(uint8_t column, uint8_t row, uint8_t c)
 {
-    int a = address(column, row);
-    writeCommand(a);
+    bool shadowed = isShadowed(column, row);
+    if (shadowed && (_shadow[row][column] == c))
+    {
+        return;
+    }
+
+    // consecutive characters need no address, the controller increments it
+    uint8_t a = address(column, row);
+    if (a != _address)
+    {
+        writeCommand(a);
+    }
     writeData(c);
+
+    // the address counter does not necessarily wrap onto the next row
+    bool incrementing = (displaymode & LCD_ENTRY_LEFT);
+    _address = (incrementing && ((column + 1) < columns())) ? (a + 1) : LCD_UNKNOWN_ADDRESS;
+    if (shadowed)
+    {
+        _shadow[row][column] = c;
+    }
+}
+
+void LCD::writeRow(uint8_t row, const char *text)
+{
+    for (uint8_t column = 0; column < columns(); column++)
+    {
+        character(column, row, (text && *text) ? *text++ : ' ');
+    }
 }
 
 void LCD::cls()
 {
     writeCommand(0x01); // cls, and set cursor to 0
-    ThisThread::sleep_for(2); // this command takes 1.64 ms
+    if (!busyflag)
+    {
+        ThisThread::sleep_for(2); // this command takes 1.64 ms
+    }
+    memset(_shadow, ' ', sizeof(_shadow));
+    _address = address(0, 0);
     locate(0, 0);
 }
 
@@ -68,7 +112,11 @@ void LCD::locate(uint8_t column, uint8_t row)
 void LCD::home()
 {
     writeCommand(LCD_RETURN_HOME);
-    ThisThread::sleep_for(2); // this command takes a long time!
+    if (!busyflag)
+    {
+        ThisThread::sleep_for(2); // this command takes a long time!
+    }
+    _address = address(0, 0);
 }
 
 void LCD::display(modes_t mode)
@@ -133,6 +181,10 @@ void LCD::create(uint8_t location, uint8_t charmap[])
     {
         writeData(charmap[i]);
     }
+
+    // the address counter now points into CGRAM. The panel redraws its
+    // characters from CGRAM by itself so the shadow remains valid
+    _address = LCD_UNKNOWN_ADDRESS;
 }
 
 int LCD::_putc(int value)
@@ -165,7 +217,33 @@ int LCD::_putc(int value)
 
 int LCD::_getc()
 {
-    return -1;
+    if (!isShadowed(_column, _row))
+    {
+        return -1;
+    }
+
+    // read back from the panel if possible, else from the shadow
+    int value = _shadow[_row][_column];
+    if (busyflag)
+    {
+        writeCommand(address(_column, _row));
+        waitUntilReady();
+        reset = 1;
+        value = readByte();
+        _address = LCD_UNKNOWN_ADDRESS;
+    }
+
+    _column++;
+    if (_column >= columns())
+    {
+        _column = 0;
+        _row++;
+        if (_row >= rows())
+        {
+            _row = 0;
+        }
+    }
+    return value;
 }
 
 void LCD::writeByte(uint8_t value)
@@ -180,21 +258,77 @@ void LCD::writeByte(uint8_t value)
     enable = 0;
     wait_us(1);
     enable = 1;
-    wait_us(40);
+    if (!busyflag)
+    {
+        wait_us(40);
+    }
+}
+
+uint8_t LCD::readByte()
+{
+    // the panel drives the bus while E is high, one nibble at a time, and
+    // moves on to the next on each falling edge; E idles high, so the high
+    // nibble is there as soon as RW is. Exactly two falling edges per byte
+    // with RW high, else the 4-bit interface loses track of the nibbles.
+    data.input();
+    readwrite = 1;
+    wait_us(1);
+    uint8_t value = (data.read() & 0x0f) << 4;
+    enable = 0;
+    wait_us(1);
+    enable = 1;
+    wait_us(1);
+    value |= (data.read() & 0x0f);
+    enable = 0;
+    wait_us(1);
+    readwrite = 0;
+    data.output();
+    enable = 1;
+    return value;
+}
+
+void LCD::waitUntilReady()
+{
+    // poll rather than wait out the worst case of every instruction; yet
+    // should the panel never get ready, give up rather than hang
+    int rs = reset;
+    reset = 0;
+    for (int elapsed = 0; elapsed < LCD_BUSY_TIMEOUT_US; elapsed += 4)
+    {
+        if (!(readByte() & LCD_BUSY_FLAG))
+        {
+            break;
+        }
+    }
+    reset = rs;
 }
 
 void LCD::writeCommand(uint8_t command)
 {
+    if (busyflag)
+    {
+        waitUntilReady();
+    }
     reset = 0;
     writeByte(command);
 }
 
 void LCD::writeData(uint8_t data)
 {
+    if (busyflag)
+    {
+        waitUntilReady();
+    }
     reset = 1;
     writeByte(data);
 }
 
+bool LCD::isShadowed(uint8_t column, uint8_t row)
+{
+    return (row < LCD_MAX_ROWS) && (column < LCD_MAX_COLUMNS) 
+        && (row < rows()) && (column < columns());
+}
+
 uint8_t LCD::address(uint8_t column, uint8_t row)
 {
     switch (type)
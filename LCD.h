@@ -60,6 +60,13 @@
 #define LCD_1_LINE                0x00
 #define LCD_5x10DOTS              0x04
 #define LCD_5x8DOTS               0x00
+// shadow framebuffer dimensions, large enough for every supported panel
+#define LCD_MAX_ROWS              4
+#define LCD_MAX_COLUMNS           20
+#define LCD_UNKNOWN_ADDRESS       0x00
+// busy flag polling
+#define LCD_BUSY_FLAG             0x80
+#define LCD_BUSY_TIMEOUT_US       2000
 
 /**
  * @brief LCD panel format
@@ -107,6 +114,11 @@ enum modes_t
  *   lcd.printf("Hello World!\n");
  * }
  * @endcode
+ *
+ * Should the RW line be wired up, the busy flag is polled rather than
+ * waiting out the worst case execution time of every instruction, and
+ * what is displayed can be read back. The panel then drives D4-D7 so 
+ * these must be 5V tolerant pins for a 5V panel.
  */
 class LCD : public Stream
 {
@@ -119,8 +131,9 @@ public:
      * @param e     Enable line (clock)
      * @param d4-d7 Data lines for using as a 4-bit interface
      * @param type  Sets the panel size/addressing mode (default = LCD16x2)
+     * @param rw    Read/write line, or NC if tied to ground (default = NC)
      */
-    LCD(PinName rs, PinName en, PinName d4, PinName d5, PinName d6, PinName d7, lcd_t type = LCD16x2);
+    LCD(PinName rs, PinName en, PinName d4, PinName d5, PinName d6, PinName d7, lcd_t type = LCD16x2, PinName rw = NC);
 
     /**
      * @brief Clear the screen and locate to 0,0
@@ -174,6 +187,7 @@ public:
 
     /**
      * @brief Writes a single char to a given position, usefull for UDC
+     * Nothing is sent to the panel should it already display c there
      *
      * @param column
      * @param row
@@ -181,6 +195,16 @@ public:
      */
     void character(uint8_t column, uint8_t row, uint8_t c);
 
+    /**
+     * @brief Writes a whole row, padding it out with spaces
+     * Only the characters that differ from what the panel already
+     * displays are sent, so rewriting an unchanged row costs nothing
+     *
+     * @param row   The vertical position from the top, indexed from 0
+     * @param text  Null terminated, truncated to the panel width
+     */
+    void writeRow(uint8_t row, const char *text);
+
 protected:
 
     // Stream implementation functions
@@ -193,9 +217,13 @@ protected:
     void writeByte(uint8_t value);
     void writeCommand(uint8_t command);
     void writeData(uint8_t data);
+    bool isShadowed(uint8_t column, uint8_t row);
+    uint8_t readByte();
+    void waitUntilReady();
 
-    DigitalOut reset, enable;
-    BusOut data;
+    DigitalOut reset, enable, readwrite;
+    BusInOut data;
+    bool busyflag;
     lcd_t type;
 
     uint8_t displaycontrol;
@@ -203,6 +231,11 @@ protected:
 
     uint8_t _column;
     uint8_t _row;
+
+    // What the panel currently displays, and where the controller's 
+    // auto-incrementing DDRAM address counter points to next
+    uint8_t _shadow[LCD_MAX_ROWS][LCD_MAX_COLUMNS];
+    uint8_t _address;
 };
 
 #endif
@@ -37,7 +37,8 @@
 * 
 *      - Good for 0-50°C temperature readings ±2°C accuracy.
 * 
-*      - No more than 1 Hz sampling rate (once every second).
+*      - No more than 1 Hz sampling rate (once every second); the DHT22
+*        no more than 0.5 Hz (once every 2 seconds).
 * 
 *      - Body size: 15.5mm x 12mm x 5.5mm. 
 *
@@ -67,9 +68,16 @@
 #include <cstdint>
 #include <string>
 #include <array>
+#include <atomic>
+#include <optional>
+#include <chrono>
+#include <compare>
+#include <algorithm>
+#include <cmath>
 #include <time.h> 
 #include "mbed.h"
-#include "Utilities.h"
+#include "NuerteyTypeTraits.h"
+#include "NuerteyDewPoint.h"
 
 #define PIN_HIGH  1
 #define PIN_LOW   0
@@ -95,7 +103,8 @@ enum class [[nodiscard]] SensorStatus_t : int8_t
     ERROR_SYNC_TIMEOUT   = -4,
     ERROR_DATA_TIMEOUT   = -5,
     ERROR_BAD_CHECKSUM   = -6,
-    ERROR_TOO_FAST_READS = -7
+    ERROR_TOO_FAST_READS = -7,
+    ERROR_QUEUE_FULL     = -8
 };
 
 enum class TemperatureScale_t : uint8_t
@@ -105,6 +114,121 @@ enum class TemperatureScale_t : uint8_t
     KELVIN
 };
 
+enum class HumidityScale_t : uint8_t
+{
+    RELATIVE_PERCENT = 0
+};
+
+namespace FixedPoint
+{
+    // Rounds half away from zero, as lroundf() would.
+    constexpr int32_t DivideRounded(const int32_t & numerator, const int32_t & denominator)
+    {
+        return (((numerator < 0) ? (numerator - (denominator / 2)) 
+                                 : (numerator + (denominator / 2))) / denominator);
+    }
+}
+
+// Fixed-point reading in tenths of a unit of Scale, as the sensors 
+// themselves report. Conversions between temperature scales are chosen
+// at compile-time and stay integer; a float only ever materializes on
+// an explicit ToFloat(), i.e. for formatting.
+template <auto Scale>
+class Reading
+{
+public:
+    constexpr Reading() = default;
+    constexpr explicit Reading(const int32_t & tenths) : m_Tenths(tenths) {}
+
+    constexpr int32_t GetTenths() const { return m_Tenths; }
+    constexpr float   ToFloat() const { return (m_Tenths / 10.0f); }
+
+    // i.e. Reading<TemperatureScale_t::CELCIUS>(215).As<TemperatureScale_t::FARENHEIT>() is 70.7°F.
+    template <TemperatureScale_t To>
+        requires std::is_same<decltype(Scale), TemperatureScale_t>::value
+    constexpr Reading<To> As() const
+    {
+        return Reading<To>(Reading<To>::FromCelsius(ToCelsius(m_Tenths)));
+    }
+
+    constexpr auto operator<=>(const Reading &) const = default;
+
+private:
+    template <auto> friend class Reading;
+
+    // Tenths cannot hold 273.15, so Kelvin carries a constant 0.05 K bias.
+    static constexpr int32_t KELVIN_OFFSET_X10   = 2732;
+    static constexpr int32_t FARENHEIT_OFFSET_X10 = 320;
+
+    static constexpr int32_t ToCelsius(const int32_t & tenths)
+    {
+        if constexpr (Scale == TemperatureScale_t::FARENHEIT)
+        {
+            return FixedPoint::DivideRounded((tenths - FARENHEIT_OFFSET_X10) * 5, 9);
+        }
+        else if constexpr (Scale == TemperatureScale_t::KELVIN)
+        {
+            return (tenths - KELVIN_OFFSET_X10);
+        }
+        else
+        {
+            return tenths;
+        }
+    }
+
+    static constexpr int32_t FromCelsius(const int32_t & tenths)
+    {
+        if constexpr (Scale == TemperatureScale_t::FARENHEIT)
+        {
+            return (FixedPoint::DivideRounded(tenths * 9, 5) + FARENHEIT_OFFSET_X10);
+        }
+        else if constexpr (Scale == TemperatureScale_t::KELVIN)
+        {
+            return (tenths + KELVIN_OFFSET_X10);
+        }
+        else
+        {
+            return tenths;
+        }
+    }
+
+    int32_t m_Tenths{0};
+};
+
+using Celsius_t   = Reading<TemperatureScale_t::CELCIUS>;
+using Farenheit_t = Reading<TemperatureScale_t::FARENHEIT>;
+using Kelvin_t    = Reading<TemperatureScale_t::KELVIN>;
+using Humidity_t  = Reading<HumidityScale_t::RELATIVE_PERCENT>;
+
+static_assert(Celsius_t(1000).As<TemperatureScale_t::FARENHEIT>() == Farenheit_t(2120)
+           && Celsius_t(-400).As<TemperatureScale_t::FARENHEIT>() == Farenheit_t(-400)
+           && Farenheit_t(707).As<TemperatureScale_t::CELCIUS>() == Celsius_t(215)
+           && Celsius_t(0).As<TemperatureScale_t::KELVIN>() == Kelvin_t(2732),
+"Hey! Fixed-point temperature conversions are off!!");
+
+// How the 40-bit data frame is sampled off the single-wire bus:
+//
+// BUSY_WAIT_POLLING - The original approach. Spin on the pin with 
+//                     wait_us() and sample each bit 40us after its 
+//                     rising edge. Simple, but burns the CPU for the 
+//                     whole frame and is at the mercy of RTOS preemption.
+//
+// EDGE_CAPTURE      - Timestamp every edge on the data pin from an
+//                     InterruptIn ISR against a free-running Timer, and
+//                     decode the bit widths only after the frame has 
+//                     been received. The reading thread is blocked on
+//                     an EventFlags wait (i.e. the CPU is free) for the
+//                     duration of the frame, and a preempted thread no 
+//                     longer corrupts the decoding.
+//
+// Only in EDGE_CAPTURE, or once ReadDataAsync() is first called, does the
+// device claim its pin's interrupt line.
+enum class AcquisitionMode_t : uint8_t
+{
+    BUSY_WAIT_POLLING = 0,
+    EDGE_CAPTURE
+};
+
 // Register for implicit conversion to error_code:
 //
 // For the SensorStatus_t enumerators to be usable as error_code constants,
@@ -122,12 +246,12 @@ public:
     virtual std::string message(int ev) const override;
 };
 
-const char* DHT11ErrorCategory::name() const noexcept
+inline const char* DHT11ErrorCategory::name() const noexcept
 {
     return "DHT11-Sensor-Mbed";
 }
 
-std::string DHT11ErrorCategory::message(int ev) const
+inline std::string DHT11ErrorCategory::message(int ev) const
 {
     switch (ToEnum<SensorStatus_t>(ev))
     {
@@ -154,6 +278,9 @@ std::string DHT11ErrorCategory::message(int ev) const
 
         case SensorStatus_t::ERROR_TOO_FAST_READS:
             return "Communication failure - too fast reads";            
+
+        case SensorStatus_t::ERROR_QUEUE_FULL:
+            return "Asynchronous read failure - event queue full";
         default:
             return "(unrecognized error)";
     }
@@ -175,6 +302,51 @@ inline auto make_error_condition(SensorStatus_t e)
     return std::error_condition(ToUnderlyingType(e), dht11_error_category());
 }
 
+// A timestamped snapshot of the most recent successful sensor read.
+struct SensorReading_t
+{
+    int64_t    timestamp_ms; // Milliseconds since the UNIX epoch.
+    Celsius_t  temperature;
+    Humidity_t humidity;
+};
+
+// Which channels of a reading are worth reporting, i.e. have moved past
+// their deadband. Both, unless a deadband filter has it otherwise.
+enum ReadingChannels_t : uint8_t
+{
+    TEMPERATURE_CHANNEL = (1U << 0),
+    HUMIDITY_CHANNEL    = (1U << 1),
+    ALL_CHANNELS        = (TEMPERATURE_CHANNEL | HUMIDITY_CHANNEL)
+};
+
+// Compact, fixed-point rendition of a reading for buffering and 
+// transmission. 16 bytes versus the 40+ of a SensorReading_t plus an
+// std::error_code.
+struct CompactReading_t
+{
+    int64_t        timestamp_ms;    // Milliseconds since the UNIX epoch.
+    int16_t        temperature_x10; // Tenths of a degree Celsius.
+    uint16_t       humidity_x10;    // Tenths of a percent relative humidity.
+    SensorStatus_t status;
+    uint8_t        channels = ALL_CHANNELS; // ReadingChannels_t, in what was padding.
+};
+
+inline CompactReading_t MakeCompactReading(const std::error_code & result, const SensorReading_t & reading)
+{
+    return CompactReading_t{reading.timestamp_ms,
+                            static_cast<int16_t>(reading.temperature.GetTenths()),
+                            static_cast<uint16_t>(reading.humidity.GetTenths()),
+                            ToEnum<SensorStatus_t, int>(result.value())};
+}
+
+// Completion handler of the asynchronous read. Invoked from the context
+// of the EventQueue that the read was issued against.
+using SensorReadingCallback_t = mbed::Callback<void(std::error_code, SensorReading_t)>;
+
+// Whence readings are stamped, in milliseconds since the UNIX epoch; 
+// e.g. a disciplined NTP clock. time(NULL) has but whole seconds.
+using TimestampSource_t = mbed::Callback<int64_t()>;
+
 // Metaprogramming types to distinguish each sensor module type:
 struct DHT11_t {};
 struct DHT22_t {};
@@ -197,12 +369,79 @@ public:
     static constexpr uint8_t DHT11_MICROCONTROLLER_RESOLUTION_BITS =  8;
     static constexpr uint8_t SINGLE_BUS_DATA_FRAME_SIZE_BYTES      =  5;
     static constexpr uint8_t MAXIMUM_DATA_FRAME_SIZE_BITS          = 40; // 5x8
-    static constexpr double  MINIMUM_SAMPLING_PERIOD_SECONDS       =  3; // Be conservative.
 
-    using DataFrameBytes_t = std::array<uint8_t, SINGLE_BUS_DATA_FRAME_SIZE_BYTES>;
-    using DataFrameBits_t  = std::array<uint8_t, MAXIMUM_DATA_FRAME_SIZE_BITS>;
+    // What the datasheets mandate between two reads, i.e. 1 Hz for the
+    // DHT11 and 0.5 Hz for the DHT22/AM2302, and hence what spaces out the
+    // retries of a failed read. Reads any more frequent than this are
+    // answered from the cache. This is the one and only minimum sampling
+    // period of the driver.
+    static constexpr auto    MINIMUM_READ_INTERVAL                 = std::is_same<T, DHT22_t>::value ? 2000ms : 1000ms;
+    static constexpr uint8_t DEFAULT_MAXIMUM_READ_RETRIES          =  2;
+
+    // Expose the template arguments to aggregators such as NuerteySensorArray.
+    using SensorType_t = T;
+    static constexpr PinName DATA_PIN_NAME                          = thePinName;
+
+    // Edge capture mode. A complete transmission consists of the sensor's
+    // response (falling + rising edge), 40 bits of (falling + rising edge)
+    // each, and the final falling edge that terminates the last bit, i.e.
+    // 2 + 80 + 1 edges. Reserve some headroom for glitches on long cables;
+    // the count alone hence cannot tell that the frame is over, an idle
+    // bus does.
+    static constexpr uint8_t  EDGE_CAPTURE_FRAME_EDGES             = 2 + (2 * MAXIMUM_DATA_FRAME_SIZE_BITS) + 1;
+    static constexpr uint8_t  EDGE_CAPTURE_MAXIMUM_EDGES           = 96;
+    static constexpr uint16_t EDGE_CAPTURE_GLITCH_US               = 10;  // Narrower than any pulse of the protocol (26us).
+    static constexpr uint16_t EDGE_CAPTURE_BUS_IDLE_US             = 200; // Twice the longest pulse of the protocol.
+    static constexpr auto     EDGE_CAPTURE_IDLE_CHECK_PERIOD       = 100us;
+    static constexpr uint16_t EDGE_CAPTURE_BIT_THRESHOLD_US        = 48;  // logic 0 is 26-28us high, logic 1 is 70us high.
+    static constexpr uint16_t EDGE_CAPTURE_MAXIMUM_ACK_US          = 100; // Sensor response is nominally 80us low, then 80us high.
+    static constexpr uint16_t EDGE_CAPTURE_MAXIMUM_PULSE_US        = 100;
+    static constexpr uint32_t EDGE_CAPTURE_FRAME_CAPTURED_FLAG     = (1UL << 0);
+    static constexpr auto     EDGE_CAPTURE_FRAME_TIMEOUT           = 10ms;  // A full frame lasts just over 5ms.
+
+    // Slow edges on long cables shorten every high pulse, the response
+    // included, by about the same amount. So the bit threshold tracks the
+    // observed response high width, less its nominal distance from it.
+    static constexpr uint16_t EDGE_CAPTURE_NOMINAL_SYNC_HIGH_US    = 80;
+    static constexpr uint16_t EDGE_CAPTURE_MINIMUM_BIT_THRESHOLD_US = 32;
+    static constexpr uint16_t EDGE_CAPTURE_MAXIMUM_BIT_THRESHOLD_US = 60;
+
+    // Busy-wait polling mode timeouts, in (approximately) microseconds.
+    static constexpr int      POLLING_MAXIMUM_RESPONSE_US          = 40;  // Sensor pulls low 20-40us after release.
+    static constexpr int      POLLING_MAXIMUM_SYNC_US              = 100; // Sensor response is nominally 80us low, then 80us high.
+    static constexpr int      POLLING_MAXIMUM_BIT_START_US         = 75;  // Bit start is nominally 50us low.
+    static constexpr int      POLLING_BIT_SAMPLE_POINT_US          = 40;  // logic 0 is 28us max, 1 is 70us.
+    static constexpr int      POLLING_MAXIMUM_BIT_VALUE_US         = 50;  // What remains of a logic 1 past the sample point.
+
+    // Pulse width histograms (edge capture only) are binned 8us apart; the
+    // last bin also catches every pulse beyond.
+    static constexpr uint8_t  SENSOR_STATUS_COUNT                  = 9;   // SUCCESS down to ERROR_QUEUE_FULL.
+    static constexpr uint8_t  PULSE_HISTOGRAM_BIN_US               = 8;
+    static constexpr uint8_t  PULSE_HISTOGRAM_BINS                 = 16;
+
+    struct HealthMetrics_t
+    {
+        std::array<uint32_t, SENSOR_STATUS_COUNT>  statusCounts;       // Per attempt, indexed by -SensorStatus_t.
+        uint32_t                                   retries;
+        uint32_t                                   throttledReads;     // Answered from the cache.
+        std::array<uint32_t, PULSE_HISTOGRAM_BINS> lowPulseHistogram;  // Bit start widths.
+        std::array<uint32_t, PULSE_HISTOGRAM_BINS> highPulseHistogram; // Bit value widths.
+        uint16_t                                   syncHighWidth;      // Of the latest response, in us.
+        uint16_t                                   bitThreshold;       // Currently in use, in us.
+    };
+
+    struct CapturedEdge_t
+    {
+        uint16_t timestamp; // Microseconds since the bus was released.
+        uint8_t  level;     // Level of the pin *after* the edge.
+    };
 
-    NuerteyDHT11Device();
+    // The 40-bit frame as shifted in off the wire, MSB first; i.e. the 
+    // humidity high byte lands in bits 39..32 and the checksum in 7..0.
+    using DataFrame_t      = uint64_t;
+    using CapturedEdges_t  = std::array<CapturedEdge_t, EDGE_CAPTURE_MAXIMUM_EDGES>;
+
+    explicit NuerteyDHT11Device(const AcquisitionMode_t & mode = AcquisitionMode_t::BUSY_WAIT_POLLING);
 
     NuerteyDHT11Device(const NuerteyDHT11Device&) = delete;
     NuerteyDHT11Device& operator=(const NuerteyDHT11Device&) = delete;
@@ -216,72 +455,221 @@ public:
 
     virtual ~NuerteyDHT11Device();
 
+    // Failed reads are retried up to GetMaximumRetries() times, no sooner
+    // than MINIMUM_READ_INTERVAL apart, before the failure is returned.
     [[nodiscard]] std::error_code ReadData();
 
-    float GetHumidity() const;
-    float GetTemperature(const TemperatureScale_t & Scale) const;
+    // Non-blocking equivalent of ReadData(). The start signal, the frame
+    // capture and the decoding are each driven as separate events on 
+    // pEventQueue (always in EDGE_CAPTURE fashion) so that the queue is 
+    // free to dispatch other work for the entire ~25ms of the transaction.
+    // onComplete is always invoked from pEventQueue, including when the 
+    // cached result is returned due to too frequent reads.
+    //
+    // Returns ERROR_BUS_BUSY if a previous asynchronous read is still in
+    // progress, or ERROR_QUEUE_FULL if pEventQueue could not take the first
+    // event, in which cases onComplete will not be invoked. Should the queue
+    // run out of events midway, onComplete is invoked with ERROR_QUEUE_FULL.
+    [[nodiscard]] std::error_code ReadDataAsync(SensorReadingCallback_t onComplete,
+                                                EventQueue * pEventQueue = mbed_event_queue());
+
+    // Abandons the asynchronous read in progress, if any, without invoking
+    // its onComplete, and leaves the bus released. Only to be called from 
+    // the context of the EventQueue that the read was issued against, or 
+    // whilst that queue is not dispatching, lest a step be running already.
+    void CancelAsyncRead();
+
+    SensorReading_t GetLastReading() const;
+
+    Humidity_t GetHumidity() const;
+
+    // i.e. GetTemperature<TemperatureScale_t::FARENHEIT>().ToFloat().
+    template <TemperatureScale_t Scale = TemperatureScale_t::CELCIUS>
+    Reading<Scale> GetTemperature() const;
+
+    // NOAA reference accuracy, in double precision. Only costs its libm 
+    // routines when used.
     float CalculateDewPoint(const float & celsius, const float & humidity) const;
+
+    // Within 0.05°C of the above for DHT11 readings and 0.32°C for DHT22
+    // ones; see NuerteyDewPoint.h.
     float CalculateDewPointFast(const float & celsius, const float & humidity) const;
 
+    AcquisitionMode_t GetAcquisitionMode() const { return m_TheAcquisitionMode; }
+
+    const HealthMetrics_t & GetHealthMetrics() const { return m_TheHealthMetrics; }
+
+    // CAUTION: Within a NuerteySensorArray, a retry a whole second later may
+    // well land on another sensor's capture window; consider 0 there.
+    uint8_t GetMaximumRetries() const { return m_TheMaximumRetries; }
+    void    SetMaximumRetries(const uint8_t & retries) { m_TheMaximumRetries = retries; }
+
+    // Until set, or once reset to nullptr, readings are stamped off time(NULL).
+    void    SetTimestampSource(TimestampSource_t source) { m_TheTimestampSource = source; }
+
+    // Translate a buffer of edge timestamps into the 40 data frame bits.
+    // Free of any hardware access so that it can equally be fed with 
+    // edges recorded elsewhere. Spikes narrower than EDGE_CAPTURE_GLITCH_US
+    // are discarded, then the frame is searched for amongst whatever else
+    // was captured; the earliest alignment whose checksum holds wins. Pulse
+    // widths and the response's high width are accounted into pMetrics, if
+    // any, for that alignment only.
+    [[nodiscard]] static SensorStatus_t DecodeCapturedEdges(const CapturedEdges_t & edges, 
+                                                            const uint8_t & count,
+                                                            DataFrame_t & frame,
+                                                            const uint16_t & bitThreshold = EDGE_CAPTURE_BIT_THRESHOLD_US,
+                                                            HealthMetrics_t * pMetrics = nullptr);
+
+    // Per the sensor device specs./data sheet, the low byte is the sum of
+    // the four above it.
+    static bool IsChecksumValid(const DataFrame_t & frame);
+
 protected:
 
 private:
+    [[nodiscard]] std::error_code ReadDataOnce();
+    [[nodiscard]] SensorStatus_t CaptureDataFrame(DigitalInOut & theIO);
+    void ReleaseBusAndArmEdgeCapture(DigitalInOut & theIO);
+    [[nodiscard]] SensorStatus_t DisarmEdgeCaptureAndDecode();
+
+    // Asynchronous read state machine steps, in order of execution.
+    [[nodiscard]] bool StartAsyncAttempt();
+    void OnAsyncRetryDue();
+    void OnAsyncBusStabilized();
+    void OnAsyncStartSignalElapsed();
+    void OnAsyncFrameCaptured();
+    void CompleteAsyncRead();
+    void FailAsyncRead();
+    void DisarmEdgeCapture();
+    void OnRisingEdge();
+    void OnFallingEdge();
+    void RecordEdge(const uint8_t & level);
+    void OnBusIdleCheck();
+
     [[nodiscard]] SensorStatus_t ExpectPulse(DigitalInOut & theIO, const int & level, const int & max_time);
     [[nodiscard]] SensorStatus_t ValidateChecksum();
 
-    float CalculateTemperature() const;
-    float CalculateHumidity() const;
-    float ConvertCelsiusToFarenheit(const float & celcius) const;
-    float ConvertCelsiusToKelvin(const float & celcius) const;
+    void CountResult(const std::error_code & result);
+    void CalibrateBitThreshold();
+
+    static bool IsRetryable(const std::error_code & result);
+
+    int64_t GetTimestampMilliseconds() const;
+
+    Celsius_t  CalculateTemperature() const;
+    Humidity_t CalculateHumidity() const;
 
     PinName              m_TheDataPinName;
-    DataFrameBytes_t     m_TheDataFrame;
-    time_t               m_TheLastReadTime;
+    DataFrame_t          m_TheDataFrame;
+    int64_t              m_TheLastReadTime;   // Epoch milliseconds.
+    Kernel::Clock::time_point m_TheLastAttemptTime;
     std::error_code      m_TheLastReadResult;
-    float                m_TheLastTemperature;
-    float                m_TheLastHumidity;
+    Celsius_t            m_TheLastTemperature;
+    Humidity_t           m_TheLastHumidity;
+
+    AcquisitionMode_t    m_TheAcquisitionMode;
+    // Engaged once edge capture is first needed, not to claim the EXTI
+    // line (and reconfigure the pin) of a device that only ever polls.
+    std::optional<InterruptIn> m_TheEdgeInterrupt;
+    Timer                m_TheEdgeTimer;
+    Ticker               m_TheIdleTicker;
+    EventFlags           m_TheCaptureFlags;
+    CapturedEdges_t      m_TheCapturedEdges;
+    std::atomic<uint8_t> m_TheCapturedEdgeCount;
+
+    DigitalInOut            m_TheAsyncDataPin;
+    EventQueue *            m_pTheAsyncEventQueue;
+    SensorReadingCallback_t m_TheAsyncCallback;
+    int                     m_TheAsyncEventId;
+    bool                    m_IsAsyncReadInProgress;
+    uint8_t                 m_TheAsyncRetriesLeft;
+
+    uint8_t                 m_TheMaximumRetries;
+    HealthMetrics_t         m_TheHealthMetrics;
+    TimestampSource_t       m_TheTimestampSource;
 };
 
 template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
-NuerteyDHT11Device<T, thePinName>::NuerteyDHT11Device()
+NuerteyDHT11Device<T, thePinName>::NuerteyDHT11Device(const AcquisitionMode_t & mode)
+    : m_TheLastTemperature{}
+    , m_TheLastHumidity{}
+    , m_TheAcquisitionMode(mode)
+    , m_TheCapturedEdges{}
+    , m_TheCapturedEdgeCount(0)
+    , m_TheAsyncDataPin(thePinName)
+    , m_pTheAsyncEventQueue(nullptr)
+    , m_TheAsyncEventId(0)
+    , m_IsAsyncReadInProgress(false)
+    , m_TheAsyncRetriesLeft(0)
+    , m_TheMaximumRetries(DEFAULT_MAXIMUM_READ_RETRIES)
+    , m_TheHealthMetrics{}
+    , m_TheTimestampSource(nullptr)
 {   
     m_TheDataPinName = thePinName;
     
-    // Using this value ensures that time(NULL) - m_TheLastReadTime will
-    // be >= MINIMUM_SAMPLING_PERIOD_SECONDS the first time. Note that  
-    // this assignment does wrap around, but so will the subtraction.
+    // Merely the timestamp of the (empty) reading until the first read.
+    m_TheLastReadTime = GetTimestampMilliseconds(); 
 
-    // Typically for POSIX, the following formulation is enough since
-    // time_t is denoted in seconds:
-    m_TheLastReadTime = time(NULL) - MINIMUM_SAMPLING_PERIOD_SECONDS; 
+    // Throttling is on the monotonic clock instead, as time() is far too
+    // coarse (1.9s may read as 1) and is stepped by NTP. Seeded such that
+    // the very first read goes ahead.
+    m_TheLastAttemptTime = Kernel::Clock::now() - MINIMUM_READ_INTERVAL;
+
+    m_TheHealthMetrics.bitThreshold = EDGE_CAPTURE_BIT_THRESHOLD_US;
+
+    if (m_TheAcquisitionMode == AcquisitionMode_t::EDGE_CAPTURE)
+    {
+        m_TheEdgeInterrupt.emplace(thePinName);
+    }
 }
 
 template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
 NuerteyDHT11Device<T, thePinName>::~NuerteyDHT11Device()
 {
+    // Any step still queued would otherwise run on a dead object.
+    CancelAsyncRead();
 }
 
 template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
 std::error_code NuerteyDHT11Device<T, thePinName>::ReadData()
 {
-    // Check if sensor was read less than two seconds ago and return 
-    // early to use last reading.
-    auto currentTime = time(NULL);
-
-    if (difftime(currentTime, m_TheLastReadTime) < MINIMUM_SAMPLING_PERIOD_SECONDS)
+    // Check if sensor was read too recently and return early to use 
+    // last reading.
+    if ((Kernel::Clock::now() - m_TheLastAttemptTime) < MINIMUM_READ_INTERVAL)
     {
+        ++m_TheHealthMetrics.throttledReads;
         return m_TheLastReadResult; // return last correct measurement
     }
 
+    auto errorCode = ReadDataOnce();
+    CountResult(errorCode);
+
+    for (uint8_t retry = 0; (retry < m_TheMaximumRetries) && IsRetryable(errorCode); retry++)
+    {
+        ++m_TheHealthMetrics.retries;
+        ThisThread::sleep_until(m_TheLastAttemptTime + MINIMUM_READ_INTERVAL);
+
+        errorCode = ReadDataOnce();
+        CountResult(errorCode);
+    }
+
+    return errorCode;
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+std::error_code NuerteyDHT11Device<T, thePinName>::ReadDataOnce()
+{
     std::error_code errorCode;
     auto result = SensorStatus_t::SUCCESS;
-    m_TheLastReadTime = currentTime;
+    m_TheLastReadTime = GetTimestampMilliseconds();
+    m_TheLastAttemptTime = Kernel::Clock::now();
 
     // Reset 40 bits of previously received data to zero.
-    m_TheDataFrame.fill(0);
+    m_TheDataFrame = 0;
 
     // DHT11 uses a simplified single-wire bidirectional communication protocol.
     // It follows a Master/Slave paradigm [NUCLEO-F767ZI=Master, DHT11=Slave] 
@@ -321,8 +709,23 @@ std::error_code NuerteyDHT11Device<T, thePinName>::ReadData()
         ThisThread::sleep_for(2ms);
     }
 
-    uint8_t i = 0, j = 0, b = 0;
-    DataFrameBits_t bitValue = {}; // Initialize to zeros.
+    if (m_TheAcquisitionMode == AcquisitionMode_t::EDGE_CAPTURE)
+    {
+        result = CaptureDataFrame(theDigitalInOutPin);
+
+        if (result == SensorStatus_t::SUCCESS)
+        {
+            result = ValidateChecksum();
+        }
+
+        if (result != SensorStatus_t::SUCCESS)
+        {
+            errorCode = make_error_code(result);
+        }
+        m_TheLastReadResult = errorCode;
+
+        return errorCode;
+    }
 
     // "...then MCU will pull up voltage and wait 20-40us for DHT’s response."
     theDigitalInOutPin.mode(PullUp);
@@ -333,7 +736,7 @@ std::error_code NuerteyDHT11Device<T, thePinName>::ReadData()
     theDigitalInOutPin.input();
 
     // Wait till the sensor grabs the bus.
-    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, 40))
+    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, POLLING_MAXIMUM_RESPONSE_US))
     {
         result = SensorStatus_t::ERROR_NOT_DETECTED;
         errorCode = make_error_code(result);
@@ -342,7 +745,7 @@ std::error_code NuerteyDHT11Device<T, thePinName>::ReadData()
     }
 
     // Sensor should signal low 80us and then hi 80us.
-    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 0, 100))
+    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 0, POLLING_MAXIMUM_SYNC_US))
     {
         result = SensorStatus_t::ERROR_SYNC_TIMEOUT;
         errorCode = make_error_code(result);
@@ -350,7 +753,7 @@ std::error_code NuerteyDHT11Device<T, thePinName>::ReadData()
         return errorCode;
     }
 
-    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, 100)) [[unlikely]]
+    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, POLLING_MAXIMUM_SYNC_US)) [[unlikely]]
     {
         result = SensorStatus_t::ERROR_TOO_FAST_READS;
         errorCode = make_error_code(result);
@@ -369,45 +772,28 @@ std::error_code NuerteyDHT11Device<T, thePinName>::ReadData()
             // library and RTOS functions inside critical section."
             //CriticalSectionLock  lock;
 
-            // capture the data
-            for (i = 0; i < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; i++)
+            // Capture the data, shifting each bit straight into the frame.
+            for (uint8_t bit = 0; bit < MAXIMUM_DATA_FRAME_SIZE_BITS; bit++)
             {
-                for (j = 0; j < DHT11_MICROCONTROLLER_RESOLUTION_BITS; j++)
+                if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 0, POLLING_MAXIMUM_BIT_START_US))
                 {
-                    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 0, 75))
-                    {
-                        result = SensorStatus_t::ERROR_DATA_TIMEOUT;
-                        errorCode = make_error_code(result);
-                        m_TheLastReadResult = errorCode;
-                        return errorCode;
-                    }
-                    // logic 0 is 28us max, 1 is 70us
-                    wait_us(40);
-                    bitValue[i*DHT11_MICROCONTROLLER_RESOLUTION_BITS + j] = theDigitalInOutPin;
-                    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, 50))
-                    {
-                        result = SensorStatus_t::ERROR_DATA_TIMEOUT;
-                        errorCode = make_error_code(result);
-                        m_TheLastReadResult = errorCode;
-                        return errorCode;
-                    }
+                    result = SensorStatus_t::ERROR_DATA_TIMEOUT;
+                    errorCode = make_error_code(result);
+                    m_TheLastReadResult = errorCode;
+                    return errorCode;
                 }
-            }
-        } // End of timing critical code.
-
-        // store the data
-        for (i = 0; i < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; i++)
-        {
-            b = 0;
-            for (j = 0; j < DHT11_MICROCONTROLLER_RESOLUTION_BITS; j++)
-            {
-                if (bitValue[i*DHT11_MICROCONTROLLER_RESOLUTION_BITS + j] == 1)
+                wait_us(POLLING_BIT_SAMPLE_POINT_US);
+                m_TheDataFrame = (m_TheDataFrame << 1) | static_cast<DataFrame_t>(theDigitalInOutPin.read() & 0x01);
+                if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, POLLING_MAXIMUM_BIT_VALUE_US))
                 {
-                    b |= (1 << (7-j));
+                    result = SensorStatus_t::ERROR_DATA_TIMEOUT;
+                    errorCode = make_error_code(result);
+                    m_TheLastReadResult = errorCode;
+                    return errorCode;
                 }
             }
-            m_TheDataFrame[i] = b;
-        }
+        } // End of timing critical code.
+
         result = ValidateChecksum();
     }
 
@@ -422,6 +808,579 @@ std::error_code NuerteyDHT11Device<T, thePinName>::ReadData()
     return errorCode;
 }
 
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+std::error_code NuerteyDHT11Device<T, thePinName>::ReadDataAsync(SensorReadingCallback_t onComplete,
+                                                                  EventQueue * pEventQueue)
+{
+    MBED_ASSERT(pEventQueue);
+
+    if (m_IsAsyncReadInProgress)
+    {
+        return make_error_code(SensorStatus_t::ERROR_BUS_BUSY);
+    }
+
+    m_IsAsyncReadInProgress = true;
+    m_pTheAsyncEventQueue = pEventQueue;
+    m_TheAsyncCallback = onComplete;
+
+    if ((Kernel::Clock::now() - m_TheLastAttemptTime) < MINIMUM_READ_INTERVAL)
+    {
+        ++m_TheHealthMetrics.throttledReads;
+
+        // Even the cached result is delivered asynchronously so that the
+        // caller can rely on a uniform calling context.
+        m_TheAsyncEventId = m_pTheAsyncEventQueue->call(this, &NuerteyDHT11Device::CompleteAsyncRead);
+        if (m_TheAsyncEventId == 0)
+        {
+            m_TheAsyncCallback = nullptr;
+            m_IsAsyncReadInProgress = false;
+            return make_error_code(SensorStatus_t::ERROR_QUEUE_FULL);
+        }
+        return {};
+    }
+
+    m_TheAsyncRetriesLeft = m_TheMaximumRetries;
+
+    // Asynchronous reads always capture edges. Claim the interrupt line
+    // now, whilst the bus is idle, rather than midway through the start
+    // signal.
+    if (!m_TheEdgeInterrupt)
+    {
+        m_TheEdgeInterrupt.emplace(thePinName);
+    }
+
+    if (!StartAsyncAttempt())
+    {
+        m_TheAsyncCallback = nullptr;
+        m_IsAsyncReadInProgress = false;
+        return make_error_code(SensorStatus_t::ERROR_QUEUE_FULL);
+    }
+
+    return {};
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+bool NuerteyDHT11Device<T, thePinName>::StartAsyncAttempt()
+{
+    m_TheLastReadTime = GetTimestampMilliseconds();
+    m_TheLastAttemptTime = Kernel::Clock::now();
+    m_TheDataFrame = 0;
+
+    m_TheAsyncDataPin.mode(PullUp);
+
+    // Just to allow things to stabilize:
+    m_TheAsyncEventId = m_pTheAsyncEventQueue->call_in(1ms, this, &NuerteyDHT11Device::OnAsyncBusStabilized);
+    return (m_TheAsyncEventId != 0);
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::OnAsyncRetryDue()
+{
+    if (!StartAsyncAttempt())
+    {
+        FailAsyncRead();
+    }
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::OnAsyncBusStabilized()
+{
+    m_TheAsyncDataPin.output();
+    m_TheAsyncDataPin = PIN_LOW;
+
+    // Same start signal durations as the synchronous ReadData(), only
+    // that we return to the EventQueue instead of sleeping on them.
+    if constexpr (std::is_same<T, DHT11_t>::value) 
+    {
+        m_TheAsyncEventId = m_pTheAsyncEventQueue->call_in(20ms, this, &NuerteyDHT11Device::OnAsyncStartSignalElapsed);
+    }
+    else if constexpr (std::is_same<T, DHT22_t>::value)
+    {
+        m_TheAsyncEventId = m_pTheAsyncEventQueue->call_in(2ms, this, &NuerteyDHT11Device::OnAsyncStartSignalElapsed);
+    }
+
+    if (m_TheAsyncEventId == 0)
+    {
+        // Do not leave the sensor held in its start signal.
+        m_TheAsyncDataPin.input();
+        FailAsyncRead();
+    }
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::OnAsyncStartSignalElapsed()
+{
+    ReleaseBusAndArmEdgeCapture(m_TheAsyncDataPin);
+
+    // The ISRs stamp the frame in the background. Come back once it 
+    // has certainly finished (or the sensor has certainly given up).
+    m_TheAsyncEventId = m_pTheAsyncEventQueue->call_in(EDGE_CAPTURE_FRAME_TIMEOUT, this, &NuerteyDHT11Device::OnAsyncFrameCaptured);
+    if (m_TheAsyncEventId == 0)
+    {
+        DisarmEdgeCapture();
+        FailAsyncRead();
+    }
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::OnAsyncFrameCaptured()
+{
+    auto result = DisarmEdgeCaptureAndDecode();
+
+    if (result == SensorStatus_t::SUCCESS)
+    {
+        result = ValidateChecksum();
+    }
+
+    std::error_code errorCode;
+    if (result != SensorStatus_t::SUCCESS)
+    {
+        errorCode = make_error_code(result);
+    }
+    CountResult(errorCode);
+
+    if ((m_TheAsyncRetriesLeft > 0) && IsRetryable(errorCode))
+    {
+        --m_TheAsyncRetriesLeft;
+
+        const auto delay = (m_TheLastAttemptTime + MINIMUM_READ_INTERVAL) - Kernel::Clock::now();
+        m_TheAsyncEventId = m_pTheAsyncEventQueue->call_in(std::max(delay, decltype(delay)::zero()), 
+                                                           this, &NuerteyDHT11Device::OnAsyncRetryDue);
+        if (m_TheAsyncEventId != 0)
+        {
+            ++m_TheHealthMetrics.retries;
+            return;
+        }
+
+        // Report the failure of the retry itself rather than this attempt's.
+        FailAsyncRead();
+        return;
+    }
+    m_TheLastReadResult = errorCode;
+
+    CompleteAsyncRead();
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::CompleteAsyncRead()
+{
+    // Clear our state before invoking the handler so that it may 
+    // immediately issue the next read.
+    auto onComplete = m_TheAsyncCallback;
+    m_TheAsyncCallback = nullptr;
+    m_TheAsyncEventId = 0;
+    m_IsAsyncReadInProgress = false;
+
+    if (onComplete)
+    {
+        onComplete(m_TheLastReadResult, GetLastReading());
+    }
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::CancelAsyncRead()
+{
+    if (!m_IsAsyncReadInProgress)
+    {
+        return;
+    }
+
+    if (m_TheAsyncEventId != 0)
+    {
+        m_pTheAsyncEventQueue->cancel(m_TheAsyncEventId);
+    }
+
+    // Whichever step was pending, the bus may be held low or armed.
+    DisarmEdgeCapture();
+    m_TheAsyncDataPin.input();
+
+    m_TheAsyncCallback = nullptr;
+    m_TheAsyncEventId = 0;
+    m_IsAsyncReadInProgress = false;
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::FailAsyncRead()
+{
+    // EventQueue context, as are all the steps that may fail to schedule
+    // their successor; hence onComplete is still invoked as promised.
+    m_TheLastReadResult = make_error_code(SensorStatus_t::ERROR_QUEUE_FULL);
+    CountResult(m_TheLastReadResult);
+
+    CompleteAsyncRead();
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+SensorReading_t NuerteyDHT11Device<T, thePinName>::GetLastReading() const
+{
+    return SensorReading_t{m_TheLastReadTime, m_TheLastTemperature, m_TheLastHumidity};
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+SensorStatus_t NuerteyDHT11Device<T, thePinName>::CaptureDataFrame(DigitalInOut & theIO)
+{
+    ReleaseBusAndArmEdgeCapture(theIO);
+    m_TheIdleTicker.attach(callback(this, &NuerteyDHT11Device::OnBusIdleCheck), EDGE_CAPTURE_IDLE_CHECK_PERIOD);
+
+    // From here on, the ISRs do all the work. Block this thread (and not
+    // the CPU) until the sensor has had its say and left the bus idle, or
+    // until it has evidently given up.
+    [[maybe_unused]] auto flags = m_TheCaptureFlags.wait_any_for(EDGE_CAPTURE_FRAME_CAPTURED_FLAG, 
+                                                                 EDGE_CAPTURE_FRAME_TIMEOUT);
+
+    return DisarmEdgeCaptureAndDecode();
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::ReleaseBusAndArmEdgeCapture(DigitalInOut & theIO)
+{
+    // Arm the edge log before releasing the bus as the sensor answers
+    // within 20-40us of the MCU pulling up.
+    m_TheCapturedEdgeCount = 0;
+    m_TheCaptureFlags.clear(EDGE_CAPTURE_FRAME_CAPTURED_FLAG);
+
+    theIO.mode(PullUp);
+    theIO = PIN_HIGH;
+
+    m_TheEdgeTimer.reset();
+    m_TheEdgeTimer.start();
+    m_TheEdgeInterrupt->rise(callback(this, &NuerteyDHT11Device::OnRisingEdge));
+    m_TheEdgeInterrupt->fall(callback(this, &NuerteyDHT11Device::OnFallingEdge));
+
+    wait_us(30);
+    theIO.input();
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::DisarmEdgeCapture()
+{
+    m_TheIdleTicker.detach();
+    if (m_TheEdgeInterrupt)
+    {
+        m_TheEdgeInterrupt->rise(nullptr);
+        m_TheEdgeInterrupt->fall(nullptr);
+    }
+    m_TheEdgeTimer.stop();
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+SensorStatus_t NuerteyDHT11Device<T, thePinName>::DisarmEdgeCaptureAndDecode()
+{
+    DisarmEdgeCapture();
+
+    m_TheHealthMetrics.syncHighWidth = 0;
+    const auto result = DecodeCapturedEdges(m_TheCapturedEdges, m_TheCapturedEdgeCount, m_TheDataFrame,
+                                            m_TheHealthMetrics.bitThreshold, &m_TheHealthMetrics);
+    CalibrateBitThreshold();
+
+    return result;
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::OnRisingEdge()
+{
+    RecordEdge(PIN_HIGH);
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::OnFallingEdge()
+{
+    RecordEdge(PIN_LOW);
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::RecordEdge(const uint8_t & level)
+{
+    // ISR context. Keep it to a timestamp and a store.
+    auto count = m_TheCapturedEdgeCount.load(std::memory_order_relaxed);
+
+    if (count < EDGE_CAPTURE_MAXIMUM_EDGES)
+    {
+        m_TheCapturedEdges[count].timestamp 
+            = static_cast<uint16_t>(m_TheEdgeTimer.elapsed_time().count());
+        m_TheCapturedEdges[count].level = level;
+        m_TheCapturedEdgeCount.store(++count, std::memory_order_release);
+    }
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::OnBusIdleCheck()
+{
+    // ISR context. The frame is over once the bus has been left alone for
+    // longer than any pulse of the protocol lasts. Until the sensor answers
+    // at all, it is for the frame timeout to give up on it.
+    const auto count = m_TheCapturedEdgeCount.load(std::memory_order_acquire);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    const auto now = static_cast<uint16_t>(m_TheEdgeTimer.elapsed_time().count());
+
+    if (static_cast<uint16_t>(now - m_TheCapturedEdges[count - 1].timestamp) >= EDGE_CAPTURE_BUS_IDLE_US)
+    {
+        m_TheIdleTicker.detach();
+        m_TheCaptureFlags.set(EDGE_CAPTURE_FRAME_CAPTURED_FLAG);
+    }
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+SensorStatus_t NuerteyDHT11Device<T, thePinName>::DecodeCapturedEdges(const CapturedEdges_t & edges, 
+                                                                      const uint8_t & count,
+                                                                      DataFrame_t & frame,
+                                                                      const uint16_t & bitThreshold,
+                                                                      HealthMetrics_t * pMetrics)
+{
+    // Expected layout of the frame, i.e. [level after the edge]:
+    //
+    // [0] LOW  - sensor grabs the bus (response, 80us low)
+    // [1] HIGH - response, 80us high
+    // [2] LOW  - bit 0 start (50us low)
+    // [3] HIGH - bit 0 value (26-28us high => 0, 70us high => 1)
+    // [4] LOW  - bit 1 start ... and so forth until
+    // [82] LOW - end of bit 39.
+    //
+    // Around it may lie stray edges from before the response or after the
+    // sensor released the bus, and within it the odd spike on long cables.
+    //
+    // First discard the spikes: a pulse narrower than any the sensor sends
+    // drops both of its edges, and an edge repeating the level before it 
+    // (its partner having been missed) is dropped likewise.
+    std::array<uint8_t, EDGE_CAPTURE_MAXIMUM_EDGES> kept;
+    uint8_t keptCount = 0;
+
+    for (uint8_t i = 0; i < std::min(count, EDGE_CAPTURE_MAXIMUM_EDGES); i++)
+    {
+        if (keptCount > 0)
+        {
+            const auto & previous = edges[kept[keptCount - 1]];
+
+            if (edges[i].level == previous.level)
+            {
+                continue;
+            }
+
+            // Unsigned arithmetic handles the (unlikely) 16-bit wraparound.
+            if (static_cast<uint16_t>(edges[i].timestamp - previous.timestamp) < EDGE_CAPTURE_GLITCH_US)
+            {
+                --keptCount;
+                continue;
+            }
+        }
+        kept[keptCount++] = i;
+    }
+
+    // Levels now strictly alternate, so a frame is fully described by the
+    // falling edge that it starts on.
+    auto width = [&edges, &kept](const uint8_t & from) -> uint16_t
+    {
+        return static_cast<uint16_t>(edges[kept[from + 1]].timestamp - edges[kept[from]].timestamp);
+    };
+
+    auto account = [](auto & histogram, const uint16_t & pulseWidth)
+    {
+        ++histogram[std::min<size_t>(pulseWidth / PULSE_HISTOGRAM_BIN_US, PULSE_HISTOGRAM_BINS - 1)];
+    };
+
+    auto decodeAt = [&](const uint8_t & first, DataFrame_t & bits, HealthMetrics_t * pAccount) -> SensorStatus_t
+    {
+        if (first + 2u >= keptCount)
+        {
+            return SensorStatus_t::ERROR_SYNC_TIMEOUT;
+        }
+
+        if (width(first) > EDGE_CAPTURE_MAXIMUM_ACK_US)
+        {
+            return SensorStatus_t::ERROR_ACK_TOO_LONG;
+        }
+
+        if (width(first + 1) > EDGE_CAPTURE_MAXIMUM_ACK_US)
+        {
+            return SensorStatus_t::ERROR_SYNC_TIMEOUT;
+        }
+
+        if (pAccount)
+        {
+            pAccount->syncHighWidth = width(first + 1);
+        }
+
+        bits = 0;
+
+        for (uint8_t bit = 0; bit < MAXIMUM_DATA_FRAME_SIZE_BITS; bit++)
+        {
+            const uint8_t low  = first + 2 + (2 * bit);
+            const uint8_t high = low + 1;
+
+            // The falling edge that terminates this bit must have been seen.
+            if (high + 1u >= keptCount)
+            {
+                return SensorStatus_t::ERROR_DATA_TIMEOUT;
+            }
+
+            if (pAccount)
+            {
+                account(pAccount->lowPulseHistogram, width(low));
+                account(pAccount->highPulseHistogram, width(high));
+            }
+
+            if ((width(low) > EDGE_CAPTURE_MAXIMUM_PULSE_US) 
+             || (width(high) > EDGE_CAPTURE_MAXIMUM_PULSE_US))
+            {
+                return SensorStatus_t::ERROR_DATA_TIMEOUT;
+            }
+
+            bits = (bits << 1) | static_cast<DataFrame_t>(width(high) > bitThreshold);
+        }
+
+        return SensorStatus_t::SUCCESS;
+    };
+
+    // Then try every falling edge in turn. Should none yield a checksummed
+    // frame, report on the earliest that decoded at all, else on the one
+    // that got the furthest, i.e. past the response.
+    int chosen = -1;
+    int decoded = -1;
+    int furthest = -1;
+    auto furthestResult = SensorStatus_t::ERROR_NOT_DETECTED;
+
+    for (uint8_t first = 0; first < keptCount; first++)
+    {
+        if (edges[kept[first]].level != PIN_LOW)
+        {
+            continue;
+        }
+
+        DataFrame_t candidate = 0;
+        const auto result = decodeAt(first, candidate, nullptr);
+
+        if (result == SensorStatus_t::SUCCESS)
+        {
+            if (IsChecksumValid(candidate))
+            {
+                chosen = first;
+                break;
+            }
+
+            if (decoded < 0)
+            {
+                decoded = first;
+            }
+        }
+        else if ((furthest < 0) 
+              || ((result == SensorStatus_t::ERROR_DATA_TIMEOUT) && (furthestResult != SensorStatus_t::ERROR_DATA_TIMEOUT)))
+        {
+            furthest = first;
+            furthestResult = result;
+        }
+
+        // None of the edges that remain could start a whole frame.
+        if ((keptCount - first) <= EDGE_CAPTURE_FRAME_EDGES)
+        {
+            break;
+        }
+    }
+
+    if (chosen < 0)
+    {
+        chosen = (decoded >= 0) ? decoded : furthest;
+    }
+
+    if (chosen < 0)
+    {
+        return SensorStatus_t::ERROR_NOT_DETECTED;
+    }
+
+    return decodeAt(static_cast<uint8_t>(chosen), frame, pMetrics);
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+bool NuerteyDHT11Device<T, thePinName>::IsChecksumValid(const DataFrame_t & frame)
+{
+    // Add the four bytes pairwise in two 16-bit lanes at once.
+    const auto data  = static_cast<uint32_t>(frame >> 8);
+    const auto lanes = (data & 0x00FF00FF) + ((data >> 8) & 0x00FF00FF);
+
+    return ((frame & 0xFF) == ((lanes + (lanes >> 16)) & 0xFF));
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::CountResult(const std::error_code & result)
+{
+    const auto index = static_cast<size_t>(-result.value());
+
+    if (index < SENSOR_STATUS_COUNT)
+    {
+        ++m_TheHealthMetrics.statusCounts[index];
+    }
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+void NuerteyDHT11Device<T, thePinName>::CalibrateBitThreshold()
+{
+    const auto syncHighWidth = m_TheHealthMetrics.syncHighWidth;
+
+    if (syncHighWidth == 0)
+    {
+        return; // The response was never seen.
+    }
+
+    const int estimate = std::clamp<int>(static_cast<int>(syncHighWidth) 
+                                       - (EDGE_CAPTURE_NOMINAL_SYNC_HIGH_US - EDGE_CAPTURE_BIT_THRESHOLD_US),
+                                         EDGE_CAPTURE_MINIMUM_BIT_THRESHOLD_US,
+                                         EDGE_CAPTURE_MAXIMUM_BIT_THRESHOLD_US);
+
+    // Smoothed over a few frames so that one glitch cannot upset it.
+    m_TheHealthMetrics.bitThreshold = static_cast<uint16_t>(((3 * m_TheHealthMetrics.bitThreshold) + estimate + 2) / 4);
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+bool NuerteyDHT11Device<T, thePinName>::IsRetryable(const std::error_code & result)
+{
+    // A sensor that is absent, or a bus that is busy, will be no different
+    // a second later; marginal timing may well be. A full queue could not
+    // schedule the retry in any case.
+    return (result 
+         && (result != SensorStatus_t::ERROR_NOT_DETECTED) 
+         && (result != SensorStatus_t::ERROR_BUS_BUSY)
+         && (result != SensorStatus_t::ERROR_QUEUE_FULL));
+}
+
+template <typename T, PinName thePinName>
+    requires IsValidPinName<thePinName>
+int64_t NuerteyDHT11Device<T, thePinName>::GetTimestampMilliseconds() const
+{
+    if (m_TheTimestampSource)
+    {
+        return m_TheTimestampSource();
+    }
+
+    return (static_cast<int64_t>(time(NULL)) * 1000);
+}
+
 template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
 SensorStatus_t NuerteyDHT11Device<T, thePinName>::ExpectPulse(DigitalInOut & theIO, const int & level, const int & max_time)
@@ -451,8 +1410,7 @@ SensorStatus_t NuerteyDHT11Device<T, thePinName>::ValidateChecksum()
 {
     auto result = SensorStatus_t::ERROR_BAD_CHECKSUM;
     
-    // Per the sensor device specs./data sheet:
-    if (m_TheDataFrame[4] == ((m_TheDataFrame[0] + m_TheDataFrame[1] + m_TheDataFrame[2] + m_TheDataFrame[3]) & 0xFF))
+    if (IsChecksumValid(m_TheDataFrame))
     {
         m_TheLastTemperature = CalculateTemperature();
         m_TheLastHumidity = CalculateHumidity();
@@ -464,94 +1422,61 @@ SensorStatus_t NuerteyDHT11Device<T, thePinName>::ValidateChecksum()
 
 template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
-float NuerteyDHT11Device<T, thePinName>::CalculateTemperature() const
+Celsius_t NuerteyDHT11Device<T, thePinName>::CalculateTemperature() const
 {
     auto v = 0;
 
     // As an alternative to SFINAE template techniques:
     if constexpr (std::is_same<T, DHT11_t>::value)
     {
-        v = m_TheDataFrame[2];
+        v = static_cast<int>((m_TheDataFrame >> 16) & 0xFF) * 10;
     }
     else if constexpr (std::is_same<T, DHT22_t>::value)
     {
-        v = m_TheDataFrame[2] & 0x7F;
-        v *= 256;
-        v += m_TheDataFrame[3];
-        v /= 10;
+        // Already in tenths, sign and magnitude.
+        v = static_cast<int>((m_TheDataFrame >> 8) & 0x7FFF);
 
-        if (m_TheDataFrame[2] & 0x80)
+        if (m_TheDataFrame & (1ULL << 23))
         {
             v *= -1;
         }
     }
 
-    return (static_cast<float>(v));
+    return Celsius_t(v);
 }
 
 template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
-float NuerteyDHT11Device<T, thePinName>::CalculateHumidity() const
+Humidity_t NuerteyDHT11Device<T, thePinName>::CalculateHumidity() const
 {
     auto v = 0;
 
     // As an alternative to SFINAE template techniques:
     if constexpr (std::is_same<T, DHT11_t>::value)
     {
-        v = m_TheDataFrame[0];
+        v = static_cast<int>((m_TheDataFrame >> 32) & 0xFF) * 10;
     }
     else if constexpr (std::is_same<T, DHT22_t>::value)
     {
-        v = m_TheDataFrame[0];
-        v *= 256;
-        v += m_TheDataFrame[1];
-        v /= 10;
+        v = static_cast<int>((m_TheDataFrame >> 24) & 0xFFFF);
     }
 
-    return (static_cast<float>(v));
-}
-
-template <typename T, PinName thePinName>
-    requires IsValidPinName<thePinName>
-float NuerteyDHT11Device<T, thePinName>::ConvertCelsiusToFarenheit(const float & celsius) const
-{
-    return ((celsius * 9/5) + 32);
-}
-
-template <typename T, PinName thePinName>
-    requires IsValidPinName<thePinName>
-float NuerteyDHT11Device<T, thePinName>::ConvertCelsiusToKelvin(const float & celsius) const
-{
-    return (celsius + 273.15);
+    return Humidity_t(v);
 }
 
 template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
-float NuerteyDHT11Device<T, thePinName>::GetHumidity() const
+Humidity_t NuerteyDHT11Device<T, thePinName>::GetHumidity() const
 {
     return m_TheLastHumidity;
 }
 
 template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
-float NuerteyDHT11Device<T, thePinName>::GetTemperature(const TemperatureScale_t & Scale) const
+template <TemperatureScale_t Scale>
+Reading<Scale> NuerteyDHT11Device<T, thePinName>::GetTemperature() const
 {
-    auto result = 0.0;
-
-    if (Scale == TemperatureScale_t::FARENHEIT)
-    {
-        result = ConvertCelsiusToFarenheit(m_TheLastTemperature);
-    }
-    else if (Scale == TemperatureScale_t::KELVIN)
-    {
-        result = ConvertCelsiusToKelvin(m_TheLastTemperature);
-    }
-    else
-    {
-        result = m_TheLastTemperature;
-    }
-
-    return result;
+    return m_TheLastTemperature.template As<Scale>();
 }
 
 template <typename T, PinName thePinName>
@@ -576,13 +1501,18 @@ template <typename T, PinName thePinName>
     requires IsValidPinName<thePinName>
 float NuerteyDHT11Device<T, thePinName>::CalculateDewPointFast(const float & celsius, const float & humidity) const
 {
-    // delta max = 0.6544 wrt dewPoint()
-    // 5x faster than dewPoint()
-    // reference: http://en.wikipedia.org/wiki/Dew_point
-    float a = 17.271;
-    float b = 237.7;
-    float temp = (a * celsius) / (b + celsius) + log(humidity/100);
-    float Td = (b * temp) / (a - temp);
+    // As an alternative to SFINAE template techniques:
+    if constexpr (std::is_same<T, DHT11_t>::value)
+    {
+        // Whole units off the wire, so the table almost always applies.
+        const auto c = static_cast<int>(lroundf(celsius));
+        const auto h = static_cast<int>(lroundf(humidity));
+
+        if (DewPoint::IsTabulated(c, h))
+        {
+            return (DewPoint::Lookup_x10(c, h) / 10.0f);
+        }
+    }
 
-    return Td;
+    return DewPoint::Approximate(celsius, humidity);
 }
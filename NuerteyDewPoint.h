@@ -0,0 +1,201 @@
+/***********************************************************************
+* @file      NuerteyDewPoint.h
+*
+*    Dew point computations cheap enough to run on every sample.
+*
+* @brief   The NOAA reference formulation costs four pow(), two log10()
+*          and a log() in double precision. Instead:
+*
+*          - DHT11 readings are whole degrees Celsius and %RH over a small
+*            range, so the reference formulation is simply tabulated for
+*            every such pair at compile-time. A lookup is all that remains.
+*
+*          - DHT22 readings are finer grained and range wider, so they go
+*            through the Magnus approximation in single precision with a
+*            polynomial logarithm, i.e. a handful of FPU instructions and
+*            one divide each way.
+*
+* @note    Accuracy against the NOAA reference formulation (as used by
+*          CalculateDewPoint()), evaluated off-target:
+*
+*          Lookup, 0..50°C, 1..100 %RH, whole units  : |error| <= 0.05°C
+*          Magnus, -40..80°C, 1..100 %RH              : |error| <= 0.32°C
+*          Magnus, 0..50°C, 20..90 %RH                : |error| <= 0.05°C
+*
+*          For calibration, the DHT11 is specified to ±2°C and ±5 %RH and
+*          the DHT22 to ±0.5°C and ±2 %RH.
+*
+* @warning   host/Benchmarks.cpp times both kernels against Reference() on
+*            a workstation, so this must not include mbed.h.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace DewPoint
+{
+    // Extent of the compile-time table, in DHT11 units.
+    static constexpr int MINIMUM_TABULATED_CELSIUS  = 0;
+    static constexpr int MAXIMUM_TABULATED_CELSIUS  = 50;
+    static constexpr int MINIMUM_TABULATED_HUMIDITY = 1;
+    static constexpr int MAXIMUM_TABULATED_HUMIDITY = 100;
+
+    namespace Detail
+    {
+        static constexpr double LN2  = 0.693147180559945309417;
+        static constexpr double LN10 = 2.302585092994045684018;
+
+        // Neither std::exp() nor std::log() is constexpr, hence these. Both
+        // are accurate to within a few ulps over the range used below.
+        constexpr double Exp(double x)
+        {
+            const auto k = static_cast<long>((x >= 0) ? (x / LN2 + 0.5) : (x / LN2 - 0.5));
+            const auto r = x - (k * LN2);
+
+            double term = 1.0;
+            double sum = 1.0;
+            for (int n = 1; n < 24; n++)
+            {
+                term *= r / n;
+                sum += term;
+            }
+
+            for (long i = 0; i < k; i++)
+            {
+                sum *= 2.0;
+            }
+            for (long i = 0; i > k; i--)
+            {
+                sum /= 2.0;
+            }
+            return sum;
+        }
+
+        constexpr double Log(double x)
+        {
+            int k = 0;
+            while (x >= 2.0)
+            {
+                x /= 2.0;
+                ++k;
+            }
+            while (x < 1.0)
+            {
+                x *= 2.0;
+                --k;
+            }
+
+            // ln(x) = 2 atanh((x - 1) / (x + 1)), with |t| <= 1/3.
+            const auto t = (x - 1.0) / (x + 1.0);
+            const auto t2 = t * t;
+            double term = t;
+            double sum = 0.0;
+            for (int n = 1; n < 40; n += 2)
+            {
+                sum += term / n;
+                term *= t2;
+            }
+            return (2.0 * sum) + (k * LN2);
+        }
+
+        constexpr double Log10(const double & x) { return (Log(x) / LN10); }
+        constexpr double Pow10(const double & x) { return Exp(x * LN10); }
+    } // namespace Detail
+
+    // NOAA, reference: http://wahiduddin.net/calc/density_algorithms.htm
+    // Identical to NuerteyDHT11Device::CalculateDewPoint() save for being
+    // usable at compile-time.
+    constexpr double Reference(const double & celsius, const double & humidity)
+    {
+        const auto A0 = 373.15 / (273.15 + celsius);
+        auto SUM = -7.90298 * (A0 - 1);
+        SUM += 5.02808 * Detail::Log10(A0);
+        SUM += -1.3816e-7 * (Detail::Pow10(11.344 * (1 - 1 / A0)) - 1);
+        SUM += 8.1328e-3 * (Detail::Pow10(-3.49149 * (A0 - 1)) - 1);
+        SUM += Detail::Log10(1013.246);
+        const auto VP = Detail::Pow10(SUM - 3) * humidity;
+        const auto T = Detail::Log(VP / 0.61078);
+
+        return (241.88 * T) / (17.558 - T);
+    }
+
+    // Tenths of a degree Celsius, indexed by [celsius][humidity] less the
+    // minima above. 5100 entries, i.e. ~10 KB of flash and no RAM.
+    using Table_t = std::array<std::array<int16_t, MAXIMUM_TABULATED_HUMIDITY - MINIMUM_TABULATED_HUMIDITY + 1>,
+                               MAXIMUM_TABULATED_CELSIUS - MINIMUM_TABULATED_CELSIUS + 1>;
+
+    constexpr Table_t MakeTable()
+    {
+        Table_t table{};
+        for (int c = MINIMUM_TABULATED_CELSIUS; c <= MAXIMUM_TABULATED_CELSIUS; c++)
+        {
+            for (int h = MINIMUM_TABULATED_HUMIDITY; h <= MAXIMUM_TABULATED_HUMIDITY; h++)
+            {
+                const auto x10 = Reference(c, h) * 10.0;
+                table[c - MINIMUM_TABULATED_CELSIUS][h - MINIMUM_TABULATED_HUMIDITY]
+                    = static_cast<int16_t>((x10 >= 0) ? (x10 + 0.5) : (x10 - 0.5));
+            }
+        }
+        return table;
+    }
+
+    inline constexpr Table_t TABLE = MakeTable();
+
+    constexpr bool IsTabulated(const int & celsius, const int & humidity)
+    {
+        return ((celsius >= MINIMUM_TABULATED_CELSIUS) && (celsius <= MAXIMUM_TABULATED_CELSIUS)
+             && (humidity >= MINIMUM_TABULATED_HUMIDITY) && (humidity <= MAXIMUM_TABULATED_HUMIDITY));
+    }
+
+    // Caller to ensure IsTabulated().
+    constexpr int16_t Lookup_x10(const int & celsius, const int & humidity)
+    {
+        return TABLE[celsius - MINIMUM_TABULATED_CELSIUS][humidity - MINIMUM_TABULATED_HUMIDITY];
+    }
+
+    // Natural logarithm in single precision without libm: split off the
+    // binary exponent, then 2 atanh((m - 1) / (m + 1)) for the mantissa
+    // recentred onto [0.75, 1.5). Absolute error < 1e-6.
+    inline float FastLog(const float & x)
+    {
+        uint32_t bits = 0;
+        memcpy(&bits, &x, sizeof(bits));
+        auto exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127;
+        bits = (bits & 0x007FFFFF) | 0x3F800000;
+
+        float m = 0.0f;
+        memcpy(&m, &bits, sizeof(m));
+
+        if (m >= 1.5f)
+        {
+            m *= 0.5f;
+            ++exponent;
+        }
+
+        const auto t = (m - 1.0f) / (m + 1.0f);
+        const auto t2 = t * t;
+        const auto series = t * (2.0f + t2 * (0.666666667f + t2 * (0.4f + t2 * 0.285714286f)));
+
+        return (series + (static_cast<float>(exponent) * 0.693147181f));
+    }
+
+    // Magnus-Tetens with the Sonntag (1990) coefficients. humidity must be
+    // positive; 0 %RH has no dew point.
+    inline float Approximate(const float & celsius, const float & humidity)
+    {
+        constexpr float a = 17.62f;
+        constexpr float b = 243.12f;
+
+        const auto gamma = ((a * celsius) / (b + celsius)) + FastLog(humidity * 0.01f);
+        return ((b * gamma) / (a - gamma));
+    }
+} // namespace DewPoint
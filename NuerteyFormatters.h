@@ -0,0 +1,122 @@
+/***********************************************************************
+* @file      NuerteyFormatters.h
+*
+*    Fixed-point formatting of readings into caller-provided buffers, for
+*    the LCD and the MQTT payloads alike.
+*
+* @brief   Split out of Utilities.h so that the formatters may be built,
+*          and benchmarked, off-target.
+*
+* @warning   Also built by host/Benchmarks.cpp, so no mbed headers.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <system_error>
+
+namespace Utility
+{
+    // None of these formatters allocates nor consults the locale. Each
+    // writes into the caller's buffer, always NUL-terminates, and returns
+    // the string's length excluding the terminator, or 0 if the buffer is
+    // too small.
+    const auto AppendLiteral = [](std::span<char> buffer, const size_t & offset, const char * literal)
+    {
+        const auto length = strlen(literal);
+        if ((offset + length) >= buffer.size())
+        {
+            if (!buffer.empty())
+            {
+                buffer[0] = '\0';
+            }
+            return size_t{0};
+        }
+
+        memcpy(buffer.data() + offset, literal, length + 1);
+        return (offset + length);
+    };
+
+    // Formats x rounded to decimalDigits (at most 6) fractional digits.
+    const auto FormatFixed = [](std::span<char> buffer, const float & x, const int & decimalDigits)
+    {
+        static constexpr int32_t POWERS_OF_TEN[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+        const auto digits = std::clamp(decimalDigits, 0, 6);
+        const auto scale = POWERS_OF_TEN[digits];
+        const long long scaled = llroundf(x * scale);
+        const auto magnitude = static_cast<unsigned long long>((scaled < 0) ? -scaled : scaled);
+
+        if (buffer.empty())
+        {
+            return size_t{0};
+        }
+
+        // Leave room for the terminator throughout.
+        char * pCursor = buffer.data();
+        char * pEnd = buffer.data() + buffer.size() - 1;
+
+        if ((scaled < 0) && (pCursor < pEnd))
+        {
+            *pCursor++ = '-';
+        }
+
+        auto [pInteger, integerError] = std::to_chars(pCursor, pEnd, magnitude / scale);
+        if (integerError != std::errc())
+        {
+            buffer[0] = '\0';
+            return size_t{0};
+        }
+        pCursor = pInteger;
+
+        if (digits > 0)
+        {
+            if ((pEnd - pCursor) < (digits + 1))
+            {
+                buffer[0] = '\0';
+                return size_t{0};
+            }
+
+            *pCursor++ = '.';
+
+            // Zero-padded fractional part, least significant digit last.
+            auto fraction = magnitude % scale;
+            for (auto i = digits - 1; i >= 0; i--)
+            {
+                pCursor[i] = static_cast<char>('0' + (fraction % 10));
+                fraction /= 10;
+            }
+            pCursor += digits;
+        }
+
+        *pCursor = '\0';
+        return static_cast<size_t>(pCursor - buffer.data());
+    };
+    
+    // i.e. "Temp: 72.50 F", sized for one row of the 16x2 LCD.
+    const auto FormatTemperature = [](std::span<char> buffer, const float & temperature)
+    {
+        auto length = AppendLiteral(buffer, 0, "Temp: ");
+        auto value = length ? FormatFixed(buffer.subspan(length), temperature, 2) : 0;
+        return value ? AppendLiteral(buffer, length + value, " F") : size_t{0};
+    };
+    
+    // i.e. "Humi: 45.00 % RH".
+    const auto FormatHumidity = [](std::span<char> buffer, const float & humidity)
+    {
+        auto length = AppendLiteral(buffer, 0, "Humi: ");
+        auto value = length ? FormatFixed(buffer.subspan(length), humidity, 2) : 0;
+        return value ? AppendLiteral(buffer, length + value, " % RH") : size_t{0};
+    };
+} // namespace Utility
@@ -0,0 +1,360 @@
+/***********************************************************************
+* @file      NuerteyJSONTokenizer.h
+*
+*    In-place JSON tokenizer, after the fashion of jsmn.
+*
+* @brief   Rather than build a DOM of strings, maps and vectors as does
+*          picojson.h, the text is merely delimited: each token records
+*          its type and where it starts and ends within the text, which is
+*          neither copied nor modified. Tokens are laid out in document
+*          order, each container's descendants directly after it, into a
+*          caller-supplied array. Nothing is allocated.
+*
+* @note    - Strings are delimited sans their quotes and are left escaped;
+*            it is for the consumer to unescape them, or to reject them.
+*          - Numbers, true, false and null are all PRIMITIVE's. Their
+*            first character tells them apart.
+*          - An object's size is its count of members, an array's that of
+*            its elements. Keys are STRING tokens whose parent is the object,
+*            directly followed by their values.
+*
+* @warning   Standard C++ only, as host/TokenizerCheck.cpp checks it on a
+*            workstation.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <span>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <charconv>
+#include <string_view>
+
+namespace JSON
+{
+    enum class TokenType_t : uint8_t
+    {
+        OBJECT,
+        ARRAY,
+        STRING,
+        PRIMITIVE
+    };
+
+    struct Token_t
+    {
+        TokenType_t type;
+        uint16_t    start;   // Of the text, past the opening quote of strings.
+        uint16_t    end;     // One past the last character, sans the closing quote.
+        uint16_t    size;    // Members or elements; 0 for strings and primitives.
+        int16_t     parent;  // Index of the enclosing container; -1 at the top.
+    };
+
+    // Tokenize() returns the number of tokens, or else one of these.
+    enum Error_t : int
+    {
+        INVALID         = -1, // Not JSON.
+        INCOMPLETE      = -2, // Ran out of text mid-value.
+        TOO_MANY_TOKENS = -3, // Ran out of tokens.
+        TOO_LONG        = -4  // Offsets would not fit the tokens' 16 bits.
+    };
+
+    namespace Detail
+    {
+        // What may come next, as far as the grammar goes.
+        enum class Expect_t : uint8_t
+        {
+            VALUE,
+            KEY,
+            COLON,
+            COMMA_OR_CLOSE,
+            NOTHING
+        };
+
+        constexpr bool IsWhitespace(const char & c)
+        {
+            return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+        }
+
+        constexpr bool IsHexadecimal(const char & c)
+        {
+            return ((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'f')) || ((c >= 'A') && (c <= 'F'));
+        }
+
+        constexpr bool IsDelimiter(const char & c)
+        {
+            return IsWhitespace(c) || (c == ',') || (c == ']') || (c == '}');
+        }
+
+        // What comes after a value depends on whether it is within a container.
+        constexpr Expect_t AfterValue(const int & parent)
+        {
+            return (parent < 0) ? Expect_t::NOTHING : Expect_t::COMMA_OR_CLOSE;
+        }
+    } // namespace Detail
+
+    constexpr int Tokenize(std::string_view text, std::span<Token_t> tokens)
+    {
+        using Detail::Expect_t;
+
+        if (text.size() > std::numeric_limits<uint16_t>::max())
+        {
+            return TOO_LONG;
+        }
+
+        size_t count = 0;
+        int parent = -1;
+        auto expect = Expect_t::VALUE;
+
+        const auto Append = [&](const TokenType_t & type, const size_t & start, const size_t & end) -> bool
+        {
+            if (count == tokens.size())
+            {
+                return false;
+            }
+
+            tokens[count] = Token_t{type, static_cast<uint16_t>(start), static_cast<uint16_t>(end),
+                                    0, static_cast<int16_t>(parent)};
+            ++count;
+            return true;
+        };
+
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            const char c = text[i];
+
+            if (Detail::IsWhitespace(c))
+            {
+                continue;
+            }
+
+            switch (c)
+            {
+                case '{':
+                case '[':
+                {
+                    if (expect != Expect_t::VALUE)
+                    {
+                        return INVALID;
+                    }
+
+                    if ((parent >= 0) && (tokens[parent].type == TokenType_t::ARRAY))
+                    {
+                        ++tokens[parent].size;
+                    }
+
+                    if (!Append((c == '{') ? TokenType_t::OBJECT : TokenType_t::ARRAY, i, 0))
+                    {
+                        return TOO_MANY_TOKENS;
+                    }
+
+                    parent = static_cast<int>(count - 1);
+                    expect = (c == '{') ? Expect_t::KEY : Expect_t::VALUE;
+                    break;
+                }
+
+                case '}':
+                case ']':
+                {
+                    const auto type = (c == '}') ? TokenType_t::OBJECT : TokenType_t::ARRAY;
+                    if ((parent < 0) || (tokens[parent].type != type))
+                    {
+                        return INVALID;
+                    }
+
+                    // Either right after a value, or else right after opening;
+                    // trailing commas are not JSON.
+                    const bool isEmpty = (tokens[parent].size == 0)
+                                      && (expect == ((type == TokenType_t::OBJECT) ? Expect_t::KEY : Expect_t::VALUE));
+                    if ((expect != Expect_t::COMMA_OR_CLOSE) && !isEmpty)
+                    {
+                        return INVALID;
+                    }
+
+                    tokens[parent].end = static_cast<uint16_t>(i + 1);
+                    parent = tokens[parent].parent;
+                    expect = Detail::AfterValue(parent);
+                    break;
+                }
+
+                case '"':
+                {
+                    if ((expect != Expect_t::VALUE) && (expect != Expect_t::KEY))
+                    {
+                        return INVALID;
+                    }
+
+                    const size_t start = i + 1;
+                    size_t j = start;
+                    for (; (j < text.size()) && (text[j] != '"'); j++)
+                    {
+                        if (static_cast<unsigned char>(text[j]) < 0x20)
+                        {
+                            return INVALID;
+                        }
+
+                        if (text[j] != '\\')
+                        {
+                            continue;
+                        }
+
+                        if (++j == text.size())
+                        {
+                            return INCOMPLETE;
+                        }
+
+                        switch (text[j])
+                        {
+                            case '"': case '\\': case '/': case 'b':
+                            case 'f': case 'n':  case 'r': case 't':
+                                break;
+                            case 'u':
+                                for (size_t k = 0; k < 4; k++)
+                                {
+                                    if (++j == text.size())
+                                    {
+                                        return INCOMPLETE;
+                                    }
+                                    if (!Detail::IsHexadecimal(text[j]))
+                                    {
+                                        return INVALID;
+                                    }
+                                }
+                                break;
+                            default:
+                                return INVALID;
+                        }
+                    }
+
+                    if (j == text.size())
+                    {
+                        return INCOMPLETE;
+                    }
+
+                    const bool isKey = (expect == Expect_t::KEY);
+                    if ((parent >= 0) && (isKey || (tokens[parent].type == TokenType_t::ARRAY)))
+                    {
+                        ++tokens[parent].size;
+                    }
+
+                    if (!Append(TokenType_t::STRING, start, j))
+                    {
+                        return TOO_MANY_TOKENS;
+                    }
+
+                    i = j;
+                    expect = isKey ? Expect_t::COLON : Detail::AfterValue(parent);
+                    break;
+                }
+
+                case ':':
+                {
+                    if (expect != Expect_t::COLON)
+                    {
+                        return INVALID;
+                    }
+
+                    expect = Expect_t::VALUE;
+                    break;
+                }
+
+                case ',':
+                {
+                    if (expect != Expect_t::COMMA_OR_CLOSE)
+                    {
+                        return INVALID;
+                    }
+
+                    expect = (tokens[parent].type == TokenType_t::OBJECT) ? Expect_t::KEY : Expect_t::VALUE;
+                    break;
+                }
+
+                default:
+                {
+                    // Numbers, true, false and null; validated loosely here
+                    // and strictly by whoever converts them.
+                    if (expect != Expect_t::VALUE)
+                    {
+                        return INVALID;
+                    }
+
+                    const size_t start = i;
+                    size_t j = start;
+                    for (; (j < text.size()) && !Detail::IsDelimiter(text[j]); j++)
+                    {
+                        const char p = text[j];
+                        if (!(((p >= '0') && (p <= '9')) || ((p >= 'a') && (p <= 'z'))
+                            || (p == '-') || (p == '+') || (p == '.') || (p == 'E')))
+                        {
+                            return INVALID;
+                        }
+                    }
+
+                    const auto literal = text.substr(start, j - start);
+                    if (!(((literal[0] >= '0') && (literal[0] <= '9')) || (literal[0] == '-')
+                        || (literal == "true") || (literal == "false") || (literal == "null")))
+                    {
+                        return INVALID;
+                    }
+
+                    if ((parent >= 0) && (tokens[parent].type == TokenType_t::ARRAY))
+                    {
+                        ++tokens[parent].size;
+                    }
+
+                    if (!Append(TokenType_t::PRIMITIVE, start, j))
+                    {
+                        return TOO_MANY_TOKENS;
+                    }
+
+                    i = j - 1;
+                    expect = Detail::AfterValue(parent);
+                    break;
+                }
+            }
+        }
+
+        if (expect != Expect_t::NOTHING)
+        {
+            return INCOMPLETE;
+        }
+
+        return static_cast<int>(count);
+    }
+
+    // The token's text; for strings, still escaped.
+    constexpr std::string_view View(std::string_view text, const Token_t & token)
+    {
+        return text.substr(token.start, token.end - token.start);
+    }
+
+    // Index of whichever token follows the one at index and its descendants.
+    constexpr size_t Skip(std::span<const Token_t> tokens, const size_t & index)
+    {
+        size_t next = index + 1;
+        while ((next < tokens.size()) && (tokens[next].start < tokens[index].end))
+        {
+            ++next;
+        }
+        return next;
+    }
+
+    // Integers only; fractions, exponents and out of range values fail.
+    template <typename Integer>
+    inline bool ToInteger(std::string_view text, const Token_t & token, Integer & value)
+    {
+        if (token.type != TokenType_t::PRIMITIVE)
+        {
+            return false;
+        }
+
+        const auto view = View(text, token);
+        const auto [end, error] = std::from_chars(view.data(), view.data() + view.size(), value);
+        return (error == std::errc()) && (end == (view.data() + view.size()));
+    }
+} // namespace JSON
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include "NuerteyLogger.h"
+#include "Utilities.h"
+
+namespace Logging
+{
+    static constexpr uint32_t LOG_RECORDS_AVAILABLE_FLAG = 0x01;
+    static constexpr uint32_t LOG_WRITER_STOP_FLAG       = 0x02;
+    static constexpr uint32_t LOG_WRITER_STACK_SIZE      = 2048;
+
+    static LogRecordRing<LOG_RECORDS> gs_TheLogRing;
+    alignas(8) static std::array<unsigned char, LOG_WRITER_STACK_SIZE> gs_TheLogWriterStack{};
+    static Thread gs_TheLogWriterThread(osPriorityLow, LOG_WRITER_STACK_SIZE, gs_TheLogWriterStack.data(), "LogWriter");
+    static std::atomic<bool> gs_IsLogWriterRunning{false};
+
+    static void WritePendingRecords(uint32_t & reportedDroppedCount)
+    {
+        for (;;)
+        {
+            while (const auto * pRecord = gs_TheLogRing.Peek())
+            {
+                // One record at a time, so that anyone still printf()'ing
+                // directly need not wait for the whole backlog.
+                Utility::g_STDIOMutex.lock();
+                fwrite(pRecord->text.data(), 1, pRecord->length, stdout);
+                Utility::g_STDIOMutex.unlock();
+
+                gs_TheLogRing.Release();
+            }
+
+            const auto droppedCount = gs_TheLogRing.GetDroppedCount();
+            if (droppedCount == reportedDroppedCount)
+            {
+                return;
+            }
+
+            // Reported through the ring like any other record, which now
+            // has room to spare. Should even that be dropped, it is counted
+            // and reported in turn.
+            LOG_WARNING("\r\nWarning! [%" PRIu32 "] log records dropped.\r\n", droppedCount - reportedDroppedCount);
+            reportedDroppedCount = droppedCount;
+        }
+    }
+
+    static void LogWriter()
+    {
+        uint32_t reportedDroppedCount = 0;
+        uint32_t flags = 0;
+
+        while (!(flags & LOG_WRITER_STOP_FLAG))
+        {
+            flags = ThisThread::flags_wait_any(LOG_RECORDS_AVAILABLE_FLAG | LOG_WRITER_STOP_FLAG);
+            WritePendingRecords(reportedDroppedCount);
+        }
+    }
+
+    void Start()
+    {
+        if (gs_IsLogWriterRunning.exchange(true))
+        {
+            return;
+        }
+
+        gs_TheLogWriterThread.start(LogWriter);
+
+        // Whatever was logged before now.
+        gs_TheLogWriterThread.flags_set(LOG_RECORDS_AVAILABLE_FLAG);
+    }
+
+    void Stop()
+    {
+        if (!gs_IsLogWriterRunning.exchange(false))
+        {
+            return;
+        }
+
+        gs_TheLogWriterThread.flags_set(LOG_WRITER_STOP_FLAG);
+        gs_TheLogWriterThread.join();
+    }
+
+    uint32_t GetDroppedCount()
+    {
+        return gs_TheLogRing.GetDroppedCount();
+    }
+
+    namespace Detail
+    {
+        void Write(const char * format, va_list arguments)
+        {
+            size_t position = 0;
+            auto pRecord = gs_TheLogRing.Claim(position);
+            if (!pRecord)
+            {
+                return;
+            }
+
+            const auto length = vsnprintf(pRecord->text.data(), pRecord->text.size(), format, arguments);
+            pRecord->length = static_cast<uint16_t>(std::clamp<int>(length, 0, pRecord->text.size() - 1));
+
+            gs_TheLogRing.Commit(position);
+
+            if (gs_IsLogWriterRunning.load(std::memory_order_relaxed))
+            {
+                gs_TheLogWriterThread.flags_set(LOG_RECORDS_AVAILABLE_FLAG);
+            }
+        }
+    } // namespace Detail
+} // namespace Logging
@@ -0,0 +1,191 @@
+/***********************************************************************
+* @file      NuerteyLogger.h
+*
+*    Non-blocking console logging: callers format into a fixed-size ring
+*    of records and a low priority thread writes them out to the UART.
+*
+* @brief   At 9600 baud, every character printf()'ed costs over a
+*          millisecond of the caller's time, and whoever holds the
+*          STDIO mutex meanwhile stalls everyone else who logs. Here, a
+*          record costs a vsnprintf() into RAM and a couple of atomics;
+*          the UART is left to whichever thread has nothing better to do.
+*
+* @note    - Any number of threads may log concurrently. Slots are claimed
+*            lock-free, i.e. with a compare-and-swap on the ring's head,
+*            and handed over to the writer once each is complete.
+*          - Should the ring overflow, the newest records are dropped and
+*            counted so that the writer can report how many went missing.
+*          - Log through the LOG_ERROR(), LOG_WARNING(), LOG_INFO() and
+*            LOG_DEBUG() macros. As with mbed-trace's tr_*() macros, those
+*            more verbose than MBED_CONF_APP_LOG_LEVEL compile to nothing,
+*            their arguments not even evaluated, yet still type checked.
+*          - Arguments are formatted in the caller, not by the writer. A
+*            va_list does not outlive the call, nor do the pointers handed
+*            to printf-style calls (i.e. c_str()'s); deferring would mean
+*            copying out every argument, strings included, which is about
+*            as costly as formatting them. And the caller's vsnprintf() is
+*            tens of microseconds, against over a millisecond per byte
+*            at the UART, which only the writer ever waits on.
+*
+* @warning   Each record is truncated to LOG_RECORD_BYTES. Not for ISRs,
+*            as vsnprintf() of the standard library may take a lock.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include "mbed.h"
+
+#if !defined(MBED_CONF_APP_LOG_LEVEL)
+#define MBED_CONF_APP_LOG_LEVEL 2
+#endif
+
+namespace Logging
+{
+    enum class LogLevel_t : uint8_t
+    {
+        ERROR   = 0,
+        WARNING = 1,
+        INFO    = 2,
+        DEBUG   = 3
+    };
+
+    static constexpr LogLevel_t COMPILED_LOG_LEVEL = static_cast<LogLevel_t>(MBED_CONF_APP_LOG_LEVEL);
+
+    static constexpr size_t LOG_RECORD_BYTES = 128;
+    static constexpr size_t LOG_RECORDS      = 32; // Power of two.
+
+    template <size_t N>
+    class LogRecordRing
+    {
+        static_assert((N > 0) && ((N & (N - 1)) == 0),
+        "Hey! LogRecordRing capacity must be a power of two!!");
+
+    public:
+        struct Record_t
+        {
+            uint16_t                             length;
+            std::array<char, LOG_RECORD_BYTES>   text;
+        };
+
+        LogRecordRing()
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        LogRecordRing(const LogRecordRing&) = delete;
+        LogRecordRing& operator=(const LogRecordRing&) = delete;
+
+        // Producer side, from any thread. Whoever is returned a record
+        // must Commit() it promptly as the writer waits on it in order.
+        Record_t * Claim(size_t & position)
+        {
+            position = m_Head.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                auto & slot = m_Slots[position & (N - 1)];
+                const auto sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (difference == 0)
+                {
+                    if (m_Head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        return &slot.record;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                else
+                {
+                    position = m_Head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void Commit(const size_t & position)
+        {
+            m_Slots[position & (N - 1)].sequence.store(position + 1, std::memory_order_release);
+        }
+
+        // Consumer side; the writer thread only.
+        const Record_t * Peek() const
+        {
+            const auto & slot = m_Slots[m_Tail & (N - 1)];
+            return (slot.sequence.load(std::memory_order_acquire) == (m_Tail + 1)) ? &slot.record : nullptr;
+        }
+
+        void Release()
+        {
+            m_Slots[m_Tail & (N - 1)].sequence.store(m_Tail + N, std::memory_order_release);
+            ++m_Tail;
+        }
+
+        uint32_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+
+    private:
+        struct Slot_t
+        {
+            std::atomic<size_t> sequence;
+            Record_t            record;
+        };
+
+        std::array<Slot_t, N>  m_Slots;
+        std::atomic<size_t>    m_Head{0};
+        size_t                 m_Tail{0};
+        std::atomic<uint32_t>  m_DroppedCount{0};
+    };
+
+    // Starts the writer thread; records logged beforehand are kept.
+    void Start();
+
+    // Writes out whatever is pending and stops the writer thread.
+    void Stop();
+
+    uint32_t GetDroppedCount();
+
+    namespace Detail
+    {
+        void Write(const char * format, va_list arguments);
+
+        MBED_PRINTF(1, 2) inline void Print(const char * format, ...)
+        {
+            va_list arguments;
+            va_start(arguments, format);
+            Write(format, arguments);
+            va_end(arguments);
+        }
+    }
+} // namespace Logging
+
+// A discarded if constexpr branch is never executed, hence neither are 
+// the arguments evaluated, but it is still compiled.
+#define NUERTEY_LOG(level, ...)                                      \
+    do                                                               \
+    {                                                                \
+        if constexpr ((level) <= Logging::COMPILED_LOG_LEVEL)        \
+        {                                                            \
+            Logging::Detail::Print(__VA_ARGS__);                     \
+        }                                                            \
+    } while (0)
+
+#define LOG_ERROR(...)   NUERTEY_LOG(Logging::LogLevel_t::ERROR, __VA_ARGS__)
+#define LOG_WARNING(...) NUERTEY_LOG(Logging::LogLevel_t::WARNING, __VA_ARGS__)
+#define LOG_INFO(...)    NUERTEY_LOG(Logging::LogLevel_t::INFO, __VA_ARGS__)
+#define LOG_DEBUG(...)   NUERTEY_LOG(Logging::LogLevel_t::DEBUG, __VA_ARGS__)
@@ -1,6 +1,9 @@
 #include "NuerteyMQTTClient.h"
-#include "Utilities.h"
+#include "NuerteyNetworkErrors.h"
+#include "NuerteyTypeTraits.h"
+#include "NuerteyLogger.h"
 #include "mbed_trace.h"
+#include "MQTTPacket.h"
 
 #define TRACE_GROUP  "NuerteyMQTTClient"
 
@@ -11,13 +14,43 @@ const std::string NuerteyMQTTClient::DEFAULT_MQTT_PASSWORD("testpassword");
 const uint32_t    NuerteyMQTTClient::DEFAULT_TIME_TO_WAIT_FOR_RECEIVED_MESSAGE_MSECS;
 
 uint64_t    NuerteyMQTTClient::m_ArrivedMessagesCount(0);
-uint64_t    NuerteyMQTTClient::m_OldMessagesCount(0);
+NuerteyMQTTClient::MessageHandler_t NuerteyMQTTClient::m_TheMessageHandler(nullptr);
 
-NuerteyMQTTClient::NuerteyMQTTClient(const std::string & server, const uint16_t & port)
+NuerteyMQTTClient::NuerteyMQTTClient(TCPSocket * pSocket, const std::string & server, const uint16_t & port)
     : m_MQTTBrokerDomainName(server)
     , m_MQTTBrokerPort(port)
-    , m_PahoMQTTclient(&Utility::m_TheSocket) // This socket MUST be already connected or else HardFault!!! 
+    , m_pSocket(pSocket)
+    , m_PahoMQTTclient(pSocket) // This socket MUST be already connected or else HardFault!!! 
     , m_IsMQTTSessionEstablished(false)
+    , m_pJWTAudience(nullptr)
+    , m_pJWTPrivateKey(nullptr)
+    , m_TheJWTLifetime(DEFAULT_JWT_LIFETIME)
+    , m_TheJWT()
+    , m_TheJWTExpiry(0)
+    , m_InFlightPublishes{}
+    , m_NextPacketId(FIRST_INFLIGHT_PACKET_ID)
+    , m_LastTransmitTime()
+    , m_LastReceiveTime()
+    , m_IsAwaitingPingResponse(false)
+    , m_TransmitBuffer{}
+    , m_ReceiveBuffer{}
+    , m_MessagePool()
+    , m_IsBatching(false)
+    , m_BatchTopic{}
+    , m_MaximumBatchSamples(0)
+    , m_MaximumBatchAge(0)
+    , m_BatchPayloadCapacity(0)
+    , m_BatchPayloadLength(0)
+    , m_BatchedSampleCount(0)
+    , m_BatchBaseTimestamp(0)
+    , m_BatchLastTimestamp(0)
+    , m_BatchEncoding(PayloadEncoding_t::JSON_TEXT)
+    , m_BatchOpenedTime()
+    , m_BatchPayload{}
+    , m_BatchReadings{}
+    , m_InFlightBatchReadings{}
+    , m_InFlightBatchCount(0)
+    , m_TheBatchCallback(nullptr)
 {
     //mbed_trace_init();
 }
@@ -26,12 +59,30 @@ NuerteyMQTTClient::~NuerteyMQTTClient()
 {
 }
 
+void NuerteyMQTTClient::EnableJWTCredentials(const char * audience, const char * privateKey,
+                                             const std::chrono::seconds & lifetime)
+{
+    if ((m_pJWTPrivateKey != privateKey) || (m_pJWTAudience != audience) || (m_TheJWTLifetime != lifetime))
+    {
+        m_TheJWT.clear();
+    }
+
+    m_pJWTAudience = audience;
+    m_pJWTPrivateKey = privateKey;
+    m_TheJWTLifetime = lifetime;
+}
+
 bool NuerteyMQTTClient::Connect()
 {
-    printf("Running NuerteyMQTTClient::Connect() ... \r\n");
+    LOG_INFO("Running NuerteyMQTTClient::Connect() ... \r\n");
     
     bool result = false;
 
+    if (m_pJWTPrivateKey && !RefreshJWTIfDue())
+    {
+        return result;
+    }
+
     // Note: Default values are not defined for members of MQTTClient_connectOptions
     // so it is good practice to specify all settings. If the MQTTClient_connectOptions
     // structure is defined as an automatic variable, all members are set to random 
@@ -48,8 +99,10 @@ bool NuerteyMQTTClient::Connect()
     //
     // cat /etc/mosquitto/conf.d/default.conf
     // cat /etc/mosquitto/mosquitto.conf
+    //
+    // Brokers that authenticate by JWT ignore the username.
     data.username.cstring = (char *)DEFAULT_MQTT_USERNAME.c_str();
-    data.password.cstring = (char *)DEFAULT_MQTT_PASSWORD.c_str();
+    data.password.cstring = m_pJWTPrivateKey ? (char *)m_TheJWT.c_str() : (char *)DEFAULT_MQTT_PASSWORD.c_str();
 
     // Broker should wipe the session each time we disconnect.
     // Otherwise our subscriptions are retained and messages
@@ -65,23 +118,26 @@ bool NuerteyMQTTClient::Connect()
     // the server will acknowledge. The keep alive interval enables the
     // client to detect when the server is no longer available without
     // having to wait for the long TCP/IP timeout. 
-    data.keepAliveInterval = 7200;
+    data.keepAliveInterval = KEEPALIVE_INTERVAL_SECONDS;
      
-    printf("\r\nm_PahoMQTTclient connecting to MQTT Broker at: \"%s:%d\" ...", 
-        m_MQTTBrokerDomainName.c_str(), m_MQTTBrokerPort);
+    LOG_INFO("\r\nm_PahoMQTTclient connecting to MQTT Broker at: \"%s:%d\" ...", 
+               m_MQTTBrokerDomainName.c_str(), m_MQTTBrokerPort);
     
     nsapi_size_or_error_t retVal;
     if ((retVal = m_PahoMQTTclient.connect(data)) != NSAPI_ERROR_OK)
     {
-        printf("Error! nm_PahoMQTTclient.connect() returned: [%d] -> %s\n", 
-              retVal, ToString(retVal).c_str());
+        LOG_ERROR("Error! nm_PahoMQTTclient.connect() returned: [%d] -> %s\n", 
+                 retVal, ToString(retVal).c_str());
     }
     else
     {
         m_IsMQTTSessionEstablished = true;
         m_ArrivedMessagesCount = 0;
-        printf("\r\n\r\nMQTT session established with broker at [%s:%d]\r\n", 
-            m_MQTTBrokerDomainName.c_str(), m_MQTTBrokerPort);
+        m_LastTransmitTime = Kernel::Clock::now();
+        m_LastReceiveTime = m_LastTransmitTime;
+        m_IsAwaitingPingResponse = false;
+        LOG_INFO("\r\n\r\nMQTT session established with broker at [%s:%d]\r\n", 
+                   m_MQTTBrokerDomainName.c_str(), m_MQTTBrokerPort);
         result = true;
     }
 
@@ -92,25 +148,58 @@ void NuerteyMQTTClient::Disconnect()
 {
     if (IsConnected())
     {
-        printf("\r\nClosing session with broker : \"%s\" ...", m_MQTTBrokerDomainName.c_str());
+        // Give the last of the publishes a chance to be acknowledged.
+        WaitForInFlightPublishes();
+
+        if (!IsConnected())
+        {
+            // The session failed meanwhile and has already been torn down.
+            return;
+        }
+
+        LOG_INFO("\r\nClosing session with broker : \"%s\" ...", m_MQTTBrokerDomainName.c_str());
         int retVal = m_PahoMQTTclient.disconnect();
         if (retVal != MQTT::SUCCESS)
         {
-            printf("\r\n\r\nError! MQTT.disconnect() returned: [%d] -> %s\n", 
-                retVal, ToString(ToEnum<MQTTConnectionError_t, int>(retVal)).c_str());
+            LOG_ERROR("\r\n\r\nError! MQTT.disconnect() returned: [%d] -> %s\n", 
+                        retVal, ToString(ToEnum<MQTTConnectionError_t, int>(retVal)).c_str());
         }
 
-        printf("\r\nClosing socket... ");
-        nsapi_error_t rc = Utility::m_TheSocket.close();
+        LOG_INFO("\r\nClosing socket... ");
+        nsapi_error_t rc = m_pSocket->close();
         if (rc != NSAPI_ERROR_OK)
         {
-            printf("\r\n\r\nError! TCP.disconnect() returned: [%d] -> %s\n", rc, ToString(rc).c_str());
+            LOG_ERROR("\r\n\r\nError! TCP.disconnect() returned: [%d] -> %s\n", rc, ToString(rc).c_str());
         }
         m_ArrivedMessagesCount = 0;
         m_IsMQTTSessionEstablished = false;
     }
 }
 
+void NuerteyMQTTClient::AbandonSession()
+{
+    LOG_WARNING("\r\n\r\nWarning! Abandoning MQTT session with [%u] publishes in flight.\n",
+                static_cast<unsigned>(GetInFlightPublishesCount()));
+
+    // Clear the flag first lest the completion callbacks publish afresh.
+    m_IsMQTTSessionEstablished = false;
+    m_IsAwaitingPingResponse = false;
+
+    for (auto & publish : m_InFlightPublishes)
+    {
+        if (publish.packetId != 0)
+        {
+            CompleteInFlightPublish(publish, false);
+        }
+    }
+
+    // The DISCONNECT is bound to fail but the Paho client resets its own
+    // session state regardless, which it must for a subsequent connect().
+    [[maybe_unused]] auto rc = m_PahoMQTTclient.disconnect();
+    m_pSocket->close();
+    m_ArrivedMessagesCount = 0;
+}
+
 void NuerteyMQTTClient::Subscribe(const char * topic)
 {
     if (strcmp(topic, "") != 0)
@@ -121,7 +210,7 @@ void NuerteyMQTTClient::Subscribe(const char * topic)
         // exactly once. Hence no duplicates or lost messages.
         if ((rc = m_PahoMQTTclient.subscribe(topic, MQTT::QOS1, NuerteyMQTTClient::MessageArrived)) != MQTT::SUCCESS)
         {
-            printf("\r\n\r\nError! MQTT.subscribe() returned: [%d].\n", rc);
+            LOG_ERROR("\r\n\r\nError! MQTT.subscribe() returned: [%d].\n", rc);
         }
     }
 }
@@ -136,98 +225,733 @@ void NuerteyMQTTClient::UnSubscribe(const char * topic)
         // exactly once. Hence no duplicates or lost messages.
         if ((rc = m_PahoMQTTclient.unsubscribe(topic)) != MQTT::SUCCESS)
         {
-            printf("\r\n\r\nError! MQTT.unsubscribe() returned: [%d].\n", rc);
+            LOG_ERROR("\r\n\r\nError! MQTT.unsubscribe() returned: [%d].\n", rc);
         }
     }
 }
 
 void NuerteyMQTTClient::Publish(const char * topic)
+{
+    Publish(topic, nullptr, 0);
+}
+
+void NuerteyMQTTClient::Publish(const char * topic, MQTT::Message & data)
+{
+    // The Paho client would swallow the PUBACKs of our pipelined publishes.
+    WaitForInFlightPublishes();
+
+    if (!IsConnected())
+    {
+        return;
+    }
+
+    // Note that for QoS1 and QoS2, the Paho client itself already blocks
+    // until the broker has acknowledged the publish. There is no need for
+    // us to additionally wait for our own message to be echoed back.
+    int rc = m_PahoMQTTclient.publish(topic, data);
+    if (rc != MQTT::SUCCESS)
+    {
+        LOG_ERROR("\r\n\r\nError! MQTT.publish() returned: [%d].\n", rc);
+
+        // Either the socket failed or the PUBACK never came.
+        AbandonSession();
+    }
+    else
+    {
+        m_LastTransmitTime = Kernel::Clock::now();
+    }
+}
+
+void NuerteyMQTTClient::Publish(const char * topic, const void * data, const size_t & size)
 {
     if (strcmp(topic, "") != 0)
     {
-        m_OldMessagesCount = m_ArrivedMessagesCount;
-        Utility::g_pMessage.reset(new MQTT::Message());
+        // As this blocks until the PUBACK, the stack outlives the message.
+        MQTT::Message message;
+
+        message.qos = MQTT::QOS1;
+        message.retained = false;
+        message.dup = false;
+        message.id = 0;
+        message.payload = const_cast<void *>(data);
+        message.payloadlen = size;
+
+        Publish(topic, message);
+    }
+}
+
+uint16_t NuerteyMQTTClient::PublishAsync(const char * topic, const void * data, const size_t & size,
+                                         PublishCallback_t onComplete)
+{
+    if (!IsConnected() || (strcmp(topic, "") == 0))
+    {
+        return 0;
+    }
+
+    const auto topicLength = strlen(topic);
+    if (topicLength > MAXIMUM_TOPIC_LENGTH)
+    {
+        LOG_ERROR("\r\n\r\nError! Topic exceeds [%u] characters: %s\n", static_cast<unsigned>(MAXIMUM_TOPIC_LENGTH), topic);
+        return 0;
+    }
+
+    auto slot = std::find_if(m_InFlightPublishes.begin(), m_InFlightPublishes.end(), 
+                             [](const InFlightPublish_t & publish){ return (publish.packetId == 0); });
+
+    if (slot == m_InFlightPublishes.end())
+    {
+        // Window is full. The caller should service the acknowledgements.
+        return 0;
+    }
+
+    *slot = InFlightPublish_t{m_NextPacketId, 0, Kernel::Clock::now(), {}, data, size, nullptr, onComplete};
+    memcpy(slot->topic.data(), topic, topicLength + 1);
+
+    // Wrap around within the upper half of the identifier space.
+    m_NextPacketId = (m_NextPacketId == 0xFFFF) ? FIRST_INFLIGHT_PACKET_ID : (m_NextPacketId + 1);
+
+    // A packet that can not be put together, e.g. for its payload being
+    // too large, is this publish's problem alone; the session is fine.
+    // Not through the completion path either way; the caller is told by
+    // the 0.
+    const auto length = SerializePublishPacket(*slot, false);
+    if (length == 0)
+    {
+        *slot = InFlightPublish_t{};
+        return 0;
+    }
+
+    if (!SendPacket(m_TransmitBuffer.data(), length))
+    {
+        *slot = InFlightPublish_t{};
+        AbandonSession();
+        return 0;
+    }
+
+    return slot->packetId;
+}
+
+NuerteyMQTTClient::MessageSlot_t * NuerteyMQTTClient::AllocateMessage()
+{
+    MessageSlot_t * pSlot = nullptr;
 
-        Utility::g_pMessage->qos = MQTT::QOS1;
-        Utility::g_pMessage->retained = false;
-        Utility::g_pMessage->dup = false;
-        Utility::g_pMessage->payload = nullptr;
-        Utility::g_pMessage->payloadlen = 0;
-        int rc = m_PahoMQTTclient.publish(topic, *Utility::g_pMessage.get());
-        if (rc != MQTT::SUCCESS)
+    while (!(pSlot = m_MessagePool.try_alloc()))
+    {
+        if (MQTT::FAILURE == ServiceInFlightPublishes())
         {
-            printf("\r\n\r\nError! MQTT.publish() returned: [%d].\n", rc);
+            return nullptr;
         }
-        else
+    }
+
+    pSlot->header.qos = MQTT::QOS1;
+    pSlot->header.retained = false;
+    pSlot->header.dup = false;
+    pSlot->header.id = 0;
+    pSlot->header.payload = pSlot->payload.data();
+    pSlot->header.payloadlen = 0;
+
+    return pSlot;
+}
+
+void NuerteyMQTTClient::ReleaseMessage(MessageSlot_t * pSlot)
+{
+    if (pSlot)
+    {
+        m_MessagePool.free(pSlot);
+    }
+}
+
+uint16_t NuerteyMQTTClient::PublishAsync(const char * topic, MessageSlot_t * pSlot,
+                                         PublishCallback_t onComplete)
+{
+    MBED_ASSERT(pSlot && (pSlot->header.payloadlen <= pSlot->payload.size()));
+
+    // Backpressure; rather wait for room than fail a composed message.
+    while (GetInFlightPublishesCount() >= MAXIMUM_INFLIGHT_PUBLISHES)
+    {
+        if (MQTT::FAILURE == ServiceInFlightPublishes())
+        {
+            break;
+        }
+    }
+
+    auto packetId = PublishAsync(topic, pSlot->payload.data(), pSlot->header.payloadlen, onComplete);
+
+    auto slot = std::find_if(m_InFlightPublishes.begin(), m_InFlightPublishes.end(), 
+                             [packetId](const InFlightPublish_t & publish){ return (publish.packetId == packetId); });
+
+    if ((packetId != 0) && (slot != m_InFlightPublishes.end()))
+    {
+        pSlot->header.id = packetId;
+        slot->pSlot = pSlot;
+    }
+    else
+    {
+        ReleaseMessage(pSlot);
+        packetId = 0;
+    }
+
+    return packetId;
+}
+
+int NuerteyMQTTClient::ServiceInFlightPublishes(const uint32_t & timeInterval)
+{
+    if (!IsConnected())
+    {
+        return MQTT::FAILURE;
+    }
+
+    int result = MQTT::SUCCESS;
+
+    // Wait up to timeInterval for the first packet, then drain whatever
+    // else has already arrived without waiting any further.
+    auto interval = timeInterval;
+    int length = 0;
+    while ((length = ReceivePacket(interval)) > 0)
+    {
+        DispatchPacket(length);
+        interval = 0;
+    }
+
+    const auto now = Kernel::Clock::now();
+
+    if (length < 0)
+    {
+        result = MQTT::FAILURE;
+    }
+    else if (length == 0) 
+    {
+        // The broker answers our pings, sent every half keep alive period,
+        // so a whole period of silence means that the session is dead.
+        if ((now - m_LastReceiveTime) >= std::chrono::seconds(KEEPALIVE_INTERVAL_SECONDS))
+        {
+            LOG_WARNING("\r\n\r\nWarning! Nothing received from broker for a whole keep alive period.\n");
+            result = MQTT::FAILURE;
+        }
+    }
+
+    for (auto & publish : m_InFlightPublishes)
+    {
+        if ((publish.packetId != 0) && ((now - publish.sentTime) >= PUBACK_TIMEOUT))
         {
-            while (m_ArrivedMessagesCount < m_OldMessagesCount + 1)
+            if (publish.retries < MAXIMUM_PUBLISH_RETRIES)
             {
-                //printf("\r\nYielding... ");
-                printf(".");
-                int retVal = Yield();
-                if (MQTT::FAILURE == retVal)
+                ++publish.retries;
+                publish.sentTime = now;
+
+                // As it was put together once already, it will be again.
+                const auto length = SerializePublishPacket(publish, true);
+                if ((length > 0) && !SendPacket(m_TransmitBuffer.data(), length))
                 {
-                    printf("\r\n\r\nWarning! MQTT.yield() indicates that for whatever reason, we have been disconnected from the broker.\n");
-                    break;
+                    result = MQTT::FAILURE;
                 }
             }
+            else
+            {
+                LOG_WARNING("\r\n\r\nWarning! No PUBACK for packet [%u] after [%u] retries.\n", 
+                            publish.packetId, publish.retries);
+                CompleteInFlightPublish(publish, false);
+            }
         }
     }
+
+    // Keep the session alive in lieu of the Paho client's yield().
+    if ((now - m_LastTransmitTime) >= (std::chrono::seconds(KEEPALIVE_INTERVAL_SECONDS) / 2))
+    {
+        int len = MQTTSerialize_pingreq(m_TransmitBuffer.data(), m_TransmitBuffer.size());
+        if ((len <= 0) || !SendPacket(m_TransmitBuffer.data(), len))
+        {
+            result = MQTT::FAILURE;
+        }
+        else
+        {
+            m_IsAwaitingPingResponse = true;
+        }
+    }
+
+    if (result == MQTT::FAILURE)
+    {
+        AbandonSession();
+    }
+
+    return result;
 }
 
-void NuerteyMQTTClient::Publish(const char * topic, MQTT::Message & data)
+void NuerteyMQTTClient::WaitForInFlightPublishes()
 {
-    m_OldMessagesCount = m_ArrivedMessagesCount;
-    int rc = m_PahoMQTTclient.publish(topic, data);
-    if (rc != MQTT::SUCCESS)
+    // On failure, the session is abandoned and with it whatever was in flight.
+    while ((GetInFlightPublishesCount() > 0) && (MQTT::FAILURE != ServiceInFlightPublishes()))
     {
-        printf("\r\n\r\nError! MQTT.publish() returned: [%d].\n", rc);
     }
-    else
+}
+
+size_t NuerteyMQTTClient::GetInFlightPublishesCount() const
+{
+    return std::count_if(m_InFlightPublishes.begin(), m_InFlightPublishes.end(), 
+                         [](const InFlightPublish_t & publish){ return (publish.packetId != 0); });
+}
+
+int NuerteyMQTTClient::SerializePublishPacket(const InFlightPublish_t & publish, const bool & isDuplicate)
+{
+    // Into m_TransmitBuffer, returning the packet's length or else 0.
+    MQTTString topicString = MQTTString_initializer;
+    topicString.cstring = const_cast<char *>(publish.topic.data());
+
+    int length = MQTTSerialize_publish(m_TransmitBuffer.data(), m_TransmitBuffer.size(), 
+                                       isDuplicate, MQTT::QOS1, false, publish.packetId,
+                                       topicString, 
+                                       static_cast<unsigned char *>(const_cast<void *>(publish.payload)),
+                                       publish.payloadLength);
+    if (length <= 0)
+    {
+        LOG_ERROR("\r\n\r\nError! MQTTSerialize_publish() returned: [%d].\n", length);
+        return 0;
+    }
+
+    return length;
+}
+
+bool NuerteyMQTTClient::SendPacket(const unsigned char * buffer, const int & length)
+{
+    int sent = 0;
+    while (sent < length)
     {
-        while (m_ArrivedMessagesCount < m_OldMessagesCount + 1)
+        nsapi_size_or_error_t rc = m_pSocket->send(buffer + sent, length - sent);
+        if (rc < 0)
         {
-            //printf("\r\nYielding... ");
-            printf(".");
-            int retVal = Yield();
-            if (MQTT::FAILURE == retVal)
+            LOG_ERROR("\r\n\r\nError! TCPSocket.send() returned: [%d] -> %s\n", rc, ToString(rc).c_str());
+            return false;
+        }
+        sent += rc;
+    }
+
+    m_LastTransmitTime = Kernel::Clock::now();
+    return true;
+}
+
+int NuerteyMQTTClient::ReceivePacket(const uint32_t & timeInterval)
+{
+    // Returns the length of the packet received into m_ReceiveBuffer,
+    // 0 if nothing arrived in time, or MQTT::FAILURE.
+    m_pSocket->set_timeout(timeInterval);
+    nsapi_size_or_error_t rc = m_pSocket->recv(m_ReceiveBuffer.data(), 1);
+    m_pSocket->set_timeout(BLOCKING_SOCKET_TIMEOUT_MILLISECONDS);
+
+    if (rc == NSAPI_ERROR_WOULD_BLOCK)
+    {
+        return 0;
+    }
+    else if (rc <= 0)
+    {
+        // 0 means that the broker has closed the connection.
+        return MQTT::FAILURE;
+    }
+
+    // Once the fixed header has arrived, the rest will follow promptly.
+    int length = 1;
+    int remainingLength = 0;
+    int multiplier = 1;
+    unsigned char encodedByte = 0;
+    do
+    {
+        if ((length > 4) || (m_pSocket->recv(&encodedByte, 1) != 1))
+        {
+            return MQTT::FAILURE;
+        }
+        m_ReceiveBuffer[length++] = encodedByte;
+        remainingLength += (encodedByte & 0x7F) * multiplier;
+        multiplier *= 128;
+    } 
+    while (encodedByte & 0x80);
+
+    if ((length + remainingLength) > static_cast<int>(m_ReceiveBuffer.size()))
+    {
+        // E.g. an oversized retained message on a subscription. Failing
+        // the session would only have it redelivered on reconnecting.
+        LOG_ERROR("\r\n\r\nError! Received MQTT packet of [%d] bytes exceeds our buffer; discarding it.\n", remainingLength);
+        return DiscardPacket(length, remainingLength) ? 0 : MQTT::FAILURE;
+    }
+
+    while (remainingLength > 0)
+    {
+        rc = m_pSocket->recv(m_ReceiveBuffer.data() + length, remainingLength);
+        if (rc <= 0)
+        {
+            return MQTT::FAILURE;
+        }
+        length += rc;
+        remainingLength -= rc;
+    }
+
+    return length;
+}
+
+bool NuerteyMQTTClient::DiscardPacket(const int & headerLength, int remainingLength)
+{
+    // Keep what fits for the PUBACK, and drain the rest into the transmit
+    // buffer, which holds nothing of value in between sends.
+    int length = headerLength;
+    while (remainingLength > 0)
+    {
+        const bool isKept = (length < static_cast<int>(m_ReceiveBuffer.size()));
+        unsigned char * pData = isKept ? (m_ReceiveBuffer.data() + length) : m_TransmitBuffer.data();
+        const int size = isKept ? std::min(remainingLength, static_cast<int>(m_ReceiveBuffer.size()) - length)
+                                : std::min(remainingLength, static_cast<int>(m_TransmitBuffer.size()));
+
+        nsapi_size_or_error_t rc = m_pSocket->recv(pData, size);
+        if (rc <= 0)
+        {
+            return false;
+        }
+        length += isKept ? rc : 0;
+        remainingLength -= rc;
+    }
+
+    m_LastReceiveTime = Kernel::Clock::now();
+
+    // Else a QoS1 PUBLISH would be redelivered to us in vain.
+    const auto typeAndFlags = m_ReceiveBuffer[0];
+    if (((typeAndFlags >> 4) == PUBLISH) && (((typeAndFlags >> 1) & 0x03) == MQTT::QOS1))
+    {
+        const int topicLength = (m_ReceiveBuffer[headerLength] << 8) | m_ReceiveBuffer[headerLength + 1];
+        const int packetIdOffset = headerLength + 2 + topicLength;
+        if ((packetIdOffset + 2) <= length)
+        {
+            const auto packetId = static_cast<unsigned short>((m_ReceiveBuffer[packetIdOffset] << 8) | m_ReceiveBuffer[packetIdOffset + 1]);
+            int len = MQTTSerialize_puback(m_TransmitBuffer.data(), m_TransmitBuffer.size(), packetId);
+            return (len > 0) && SendPacket(m_TransmitBuffer.data(), len);
+        }
+    }
+
+    return true;
+}
+
+void NuerteyMQTTClient::DispatchPacket(const int & length)
+{
+    m_LastReceiveTime = Kernel::Clock::now();
+
+    const auto packetType = (m_ReceiveBuffer[0] >> 4);
+
+    if (packetType == PINGRESP)
+    {
+        m_IsAwaitingPingResponse = false;
+    }
+    else if (packetType == PUBACK)
+    {
+        unsigned char type = 0;
+        unsigned char dup = 0;
+        unsigned short packetId = 0;
+
+        if (MQTTDeserialize_ack(&type, &dup, &packetId, m_ReceiveBuffer.data(), length) == 1)
+        {
+            auto slot = std::find_if(m_InFlightPublishes.begin(), m_InFlightPublishes.end(), 
+                                     [packetId](const InFlightPublish_t & publish){ return (publish.packetId == packetId); });
+
+            // A PUBACK for a retransmitted, already completed publish is benign.
+            if (slot != m_InFlightPublishes.end())
+            {
+                CompleteInFlightPublish(*slot, true);
+            }
+        }
+    }
+    else if (packetType == PUBLISH)
+    {
+        // Messages on our subscriptions; hand them to the same handler
+        // that the Paho client would have.
+        MQTTString topicName = MQTTString_initializer;
+        MQTT::Message message;
+        int qos = 0;
+        int payloadLength = 0;
+        unsigned char * pPayload = nullptr;
+        unsigned char dup = 0;
+        unsigned char retained = 0;
+
+        if (MQTTDeserialize_publish(&dup, &qos, &retained, &message.id, &topicName,
+                                    &pPayload, &payloadLength, m_ReceiveBuffer.data(), length) == 1)
+        {
+            message.qos = static_cast<MQTT::QoS>(qos);
+            message.dup = dup;
+            message.retained = retained;
+            message.payload = pPayload;
+            message.payloadlen = payloadLength;
+
+            MQTT::MessageData data(topicName, message);
+            MessageArrived(data);
+
+            if (message.qos == MQTT::QOS1)
             {
-                printf("\r\n\r\nWarning! MQTT.yield() indicates that for whatever reason, we have been disconnected from the broker.\n");
-                break;
+                int len = MQTTSerialize_puback(m_TransmitBuffer.data(), m_TransmitBuffer.size(), message.id);
+                if ((len <= 0) || !SendPacket(m_TransmitBuffer.data(), len))
+                {
+                    LOG_ERROR("\r\n\r\nError! Failed to PUBACK packet [%u].\n", message.id);
+                }
             }
         }
     }
 }
 
-void NuerteyMQTTClient::Publish(const char * topic, const void * data, const size_t & size)
+void NuerteyMQTTClient::CompleteInFlightPublish(InFlightPublish_t & publish, const bool & acknowledged)
 {
-    m_OldMessagesCount = m_ArrivedMessagesCount;
-    Utility::g_pMessage.reset(new MQTT::Message());
+    // Free the slot before invoking the callback so that it may publish.
+    auto packetId = publish.packetId;
+    auto onComplete = publish.onComplete;
+    ReleaseMessage(publish.pSlot);
+    publish = InFlightPublish_t{};
 
-    Utility::g_pMessage->qos = MQTT::QOS1;
-    Utility::g_pMessage->retained = false;
-    Utility::g_pMessage->dup = false;
-    Utility::g_pMessage->payload = (void*)data;
-    Utility::g_pMessage->payloadlen = size;
-    int rc = m_PahoMQTTclient.publish(topic, *Utility::g_pMessage.get());
-    if (rc != MQTT::SUCCESS)
+    if (onComplete)
     {
-        printf("\r\n\r\nError! MQTT.publish() returned: [%d].\n", rc);
+        onComplete(packetId, acknowledged);
     }
-    else
+}
+
+void NuerteyMQTTClient::EnableBatching(const char * topic, const size_t & maximumSamples, const std::chrono::milliseconds & maximumAge,
+                                       const PayloadEncoding_t & encoding)
+{
+    MBED_ASSERT(topic && (maximumSamples > 0));
+
+    // Do not strand whatever might have been batched for another topic.
+    if (!FlushBatch())
+    {
+        ReturnBatch();
+    }
+
+    const auto topicLength = strlen(topic);
+    if (topicLength > MAXIMUM_TOPIC_LENGTH)
+    {
+        LOG_ERROR("\r\n\r\nError! Batch topic exceeds [%u] characters: %s\n", static_cast<unsigned>(MAXIMUM_TOPIC_LENGTH), topic);
+        m_IsBatching = false;
+        m_BatchTopic[0] = '\0';
+        return;
+    }
+
+    // What a pooled message, which the batch is sent from, can hold. That
+    // leaves room in one packet for the MQTT headers and any topic above.
+    m_BatchPayloadCapacity = MAXIMUM_PAYLOAD_SIZE_BYTES;
+
+    memcpy(m_BatchTopic.data(), topic, topicLength + 1);
+    m_MaximumBatchSamples = std::min(maximumSamples, MAXIMUM_BATCH_SAMPLES);
+    m_MaximumBatchAge = maximumAge;
+    m_BatchEncoding = encoding;
+    m_BatchPayloadLength = 0;
+    m_BatchedSampleCount = 0;
+    m_IsBatching = (m_BatchPayloadCapacity > 0);
+}
+
+void NuerteyMQTTClient::DisableBatching()
+{
+    if (!FlushBatch())
+    {
+        ReturnBatch();
+    }
+    m_IsBatching = false;
+    m_BatchTopic[0] = '\0';
+}
+
+bool NuerteyMQTTClient::Batch(const CompactReading_t & reading)
+{
+    if (!m_IsBatching)
+    {
+        return false;
+    }
+
+    // A full batch that could not go out yet takes no more.
+    if ((m_BatchedSampleCount >= MAXIMUM_BATCH_SAMPLES) && !FlushBatch())
+    {
+        return false;
+    }
+
+    // Room for the closing "]}" must always remain.
+    const size_t TRAILER_BYTES = (m_BatchEncoding == PayloadEncoding_t::JSON_TEXT) ? 2 : 0;
+
+    for (auto attempt = 0; attempt < 2; attempt++)
     {
-        while (m_ArrivedMessagesCount < m_OldMessagesCount + 1)
+        bool   fits = false;
+        size_t written = 0;
+        char * pCursor = m_BatchPayload.data() + m_BatchPayloadLength;
+        size_t available = m_BatchPayloadCapacity - TRAILER_BYTES - m_BatchPayloadLength;
+
+        if (m_BatchedSampleCount == 0)
+        {
+            m_BatchBaseTimestamp = reading.timestamp_ms;
+            m_BatchLastTimestamp = reading.timestamp_ms;
+            m_BatchOpenedTime = Kernel::Clock::now();
+        }
+
+        if (m_BatchEncoding != PayloadEncoding_t::JSON_TEXT)
+        {
+            std::span<uint8_t> frame(reinterpret_cast<uint8_t *>(pCursor), available);
+            size_t header = 0;
+
+            // Version 1 frames are in whole seconds, version 2 ones in
+            // milliseconds.
+            const bool isMilliseconds = (m_BatchEncoding == PayloadEncoding_t::COMPACT_BINARY_MILLISECONDS);
+            const auto unit = isMilliseconds ? 1 : 1000;
+
+            if (m_BatchedSampleCount == 0)
+            {
+                header = isMilliseconds 
+                       ? TelemetryCodec::EncodeMillisecondsHeader(frame, static_cast<uint64_t>(reading.timestamp_ms))
+                       : TelemetryCodec::EncodeHeader(frame, static_cast<uint32_t>(reading.timestamp_ms / 1000));
+                frame = frame.subspan(header);
+            }
+
+            const auto now = reading.timestamp_ms / unit;
+            const auto last = m_BatchLastTimestamp / unit;
+            const auto delta = (now > last) ? static_cast<uint32_t>(now - last) : 0u;
+            const auto sample = TelemetryCodec::EncodeSample(frame, {delta, reading.temperature_x10, reading.humidity_x10});
+
+            // Both fail with 0 rather than truncate, hence no terminator 
+            // to account for unlike with snprintf() below.
+            fits = ((header > 0) || (m_BatchedSampleCount > 0)) && (sample > 0);
+            written = header + sample;
+        }
+        else
         {
-            //printf("\r\nYielding... ");
-            printf(".");
-            int retVal = Yield();
-            if (MQTT::FAILURE == retVal)
+            int length = 0;
+
+            if (m_BatchedSampleCount == 0)
+            {
+                length = snprintf(pCursor, available, "{\"v\":2,\"t0\":%lld,\"s\":[[0,%d,%u]", 
+                                  static_cast<long long>(reading.timestamp_ms),
+                                  reading.temperature_x10, reading.humidity_x10);
+            }
+            else
             {
-                printf("\r\n\r\nWarning! MQTT.yield() indicates that for whatever reason, we have been disconnected from the broker.\n");
-                break;
+                length = snprintf(pCursor, available, ",[%lld,%d,%u]", 
+                                  static_cast<long long>(reading.timestamp_ms - m_BatchBaseTimestamp),
+                                  reading.temperature_x10, reading.humidity_x10);
             }
+
+            fits = (length > 0) && (static_cast<size_t>(length) < available);
+            written = static_cast<size_t>(length);
+        }
+
+        if (fits)
+        {
+            m_BatchPayloadLength += written;
+            m_BatchLastTimestamp = reading.timestamp_ms;
+            m_BatchReadings[m_BatchedSampleCount++] = reading;
+            break;
+        }
+
+        // Would not fit. Ship what we have and start afresh, unless it has
+        // to be held on to, in which case this sample is not taken. Nor is
+        // one that does not even fit into an empty batch.
+        if (m_BatchedSampleCount == 0)
+        {
+            LOG_ERROR("\r\n\r\nError! Batch payload capacity [%d] is too small for even one sample.\n", 
+                      static_cast<int>(m_BatchPayloadCapacity));
+            return false;
         }
+
+        if (!FlushBatch())
+        {
+            return false;
+        }
+    }
+
+    if (m_BatchedSampleCount >= m_MaximumBatchSamples)
+    {
+        // Else retried by FlushBatchIfDue().
+        FlushBatch();
     }
+
+    return true;
+}
+
+bool NuerteyMQTTClient::FlushBatch()
+{
+    if (!m_IsBatching || (m_BatchedSampleCount == 0))
+    {
+        return true;
+    }
+
+    // While offline, or while the previous batch awaits its PUBACK, hold 
+    // on to this one.
+    if (!IsConnected() || (m_InFlightBatchCount > 0))
+    {
+        return false;
+    }
+
+    // Copy out so that the next batch may start accumulating straightaway
+    // while this one awaits its PUBACK. The trailer goes on the copy only,
+    // lest the batch be held and appended to after all.
+    auto pSlot = AllocateMessage();
+    if (!pSlot)
+    {
+        return false;
+    }
+
+    memcpy(pSlot->payload.data(), m_BatchPayload.data(), m_BatchPayloadLength);
+    auto length = m_BatchPayloadLength;
+
+    if (m_BatchEncoding == PayloadEncoding_t::JSON_TEXT)
+    {
+        pSlot->payload[length++] = ']';
+        pSlot->payload[length++] = '}';
+    }
+    pSlot->header.payloadlen = length;
+
+    // The samples go along, should they have to be handed back.
+    std::copy_n(m_BatchReadings.begin(), m_BatchedSampleCount, m_InFlightBatchReadings.begin());
+    m_InFlightBatchCount = m_BatchedSampleCount;
+
+    if (!PublishAsync(m_BatchTopic.data(), pSlot, callback(this, &NuerteyMQTTClient::OnBatchPublished)))
+    {
+        // Not through the completion path; the batch is still ours.
+        m_InFlightBatchCount = 0;
+
+        LOG_ERROR("\r\n\r\nError! Failed to publish batch of [%d] samples; held.\n", 
+                  static_cast<int>(m_BatchedSampleCount));
+        return false;
+    }
+
+    m_BatchPayloadLength = 0;
+    m_BatchedSampleCount = 0;
+    return true;
+}
+
+void NuerteyMQTTClient::FlushBatchIfDue()
+{
+    if (m_IsBatching && (m_BatchedSampleCount > 0) 
+        && ((m_BatchedSampleCount >= m_MaximumBatchSamples)
+         || ((Kernel::Clock::now() - m_BatchOpenedTime) >= m_MaximumBatchAge)))
+    {
+        FlushBatch();
+    }
+}
+
+void NuerteyMQTTClient::OnBatchPublished(uint16_t packetId, bool acknowledged)
+{
+    const auto count = std::exchange(m_InFlightBatchCount, 0);
+
+    if (!acknowledged)
+    {
+        LOG_WARNING("\r\n\r\nWarning! Batch [%u] of [%u] samples unacknowledged; handed back with [%u] more.\n", 
+                    packetId, static_cast<unsigned>(count), static_cast<unsigned>(m_BatchedSampleCount));
+    }
+
+    if (m_TheBatchCallback)
+    {
+        m_TheBatchCallback(std::span<const CompactReading_t>(m_InFlightBatchReadings.data(), count), acknowledged);
+    }
+
+    // Whatever accumulated behind it goes back too, so as to stay in order.
+    if (!acknowledged)
+    {
+        ReturnBatch();
+    }
+}
+
+void NuerteyMQTTClient::ReturnBatch()
+{
+    if ((m_BatchedSampleCount > 0) && m_TheBatchCallback)
+    {
+        m_TheBatchCallback(std::span<const CompactReading_t>(m_BatchReadings.data(), m_BatchedSampleCount), false);
+    }
+
+    m_BatchPayloadLength = 0;
+    m_BatchedSampleCount = 0;
 }
 
 int NuerteyMQTTClient::Yield(const uint32_t & timeInterval)
@@ -241,33 +965,37 @@ int NuerteyMQTTClient::Yield(const uint32_t & timeInterval)
 void NuerteyMQTTClient::MessageArrived(MQTT::MessageData & data)
 {
     MQTT::Message &message = data.message;
-    printf("\r\nMessage arrived: qos %d, retained %d, dup %d, packetid %d\r\n", message.qos, message.retained, message.dup, message.id);
-    printf("\r\ndata.topicName.lenstring.data :-> %.*s\r\n", data.topicName.lenstring.len, data.topicName.lenstring.data);
-    printf("\r\nmessage.payloadlen :-> %d\r\n", message.payloadlen);
+    LOG_INFO("\r\nMessage arrived: qos %d, retained %d, dup %d, packetid %d\r\n", message.qos, message.retained, message.dup, message.id);
+    LOG_INFO("\r\ndata.topicName.lenstring.data :-> %.*s\r\n", data.topicName.lenstring.len, data.topicName.lenstring.data);
+    LOG_INFO("\r\nmessage.payloadlen :-> %u\r\n", static_cast<unsigned>(message.payloadlen));
 
     if (message.qos == MQTT::QOS0)
     {
-        printf("\r\nMQTT::QOS0\r\n");
+        LOG_INFO("\r\nMQTT::QOS0\r\n");
     }
     else if (message.qos == MQTT::QOS1)
     {
-        printf("\r\nMQTT::QOS1\r\n");
+        LOG_INFO("\r\nMQTT::QOS1\r\n");
     }
     else if (message.qos == MQTT::QOS2)
     {
-        printf("\r\nMQTT::QOS2\r\n");
+        LOG_INFO("\r\nMQTT::QOS2\r\n");
     }
     else
     {
-        printf("\r\nMQTT::QOS??? :-> %d\r\n", message.qos);
+        LOG_INFO("\r\nMQTT::QOS??? :-> %d\r\n", message.qos);
     }
 
     if (message.payloadlen > 0)
     {
-        printf("Binary Payload : \r\n\r\n%.*s\r\n", message.payloadlen, (char*)message.payload);
+        LOG_INFO("Binary Payload : \r\n\r\n%.*s\r\n", static_cast<int>(message.payloadlen), (char*)message.payload);
     }
 
-    // Allow Yield to break out... implies some tricky context switching here.
-    // Asynchronous callback from the underlying client versus our synchronuous context of the main thread.
     ++m_ArrivedMessagesCount;
+
+    if (m_TheMessageHandler)
+    {
+        m_TheMessageHandler(data.topicName.lenstring.data, data.topicName.lenstring.len,
+                            static_cast<const char *>(message.payload), message.payloadlen);
+    }
 }
@@ -38,6 +38,36 @@
 * 
 *           [4] Ensure that MQTT messages' lifelines last until yield() 
 *           occurs for actual message transmission so as not to segfault.
+*           Messages from AllocateMessage() satisfy this by construction;
+*           they return to the pool only once their PUBACK has arrived.
+* 
+*           [5] PublishAsync() pipelines QoS1 publishes. Up to 
+*           MAXIMUM_INFLIGHT_PUBLISHES packets may await their PUBACK at 
+*           once; ServiceInFlightPublishes() matches the PUBACKs up to their
+*           completion callbacks and retransmits (DUP) on timeout. While 
+*           publishes are in flight, do not invoke Yield() as the Paho client
+*           silently discards the PUBACKs it did not request itself.
+* 
+*           [6] Automatic reconnects are left to the application. Once a
+*           publish or ServiceInFlightPublishes() has reported the session
+*           as broken, IsConnected() returns false and the socket has been 
+*           closed; reopen it and Connect() afresh.
+* 
+*           [7] In batching mode, samples are coalesced into one payload
+*           per topic and only transmitted when either the sample count 
+*           or the age threshold is reached, or when the next sample would
+*           no longer fit in one packet. One batch at a time is in flight;
+*           the next accumulates meanwhile. A batch is only let go of once
+*           the broker has acknowledged it, else its samples are handed 
+*           back through the BatchCallback_t for the application to requeue.
+*           Payloads are formatted as:
+* 
+*           {"v":2,"t0":<epoch ms of 1st sample>,"s":[[<ms since t0>,<C x10>,<%RH x10>],...]}
+* 
+*           or, with PayloadEncoding_t::COMPACT_BINARY, as the frames laid
+*           out in NuerteyTelemetryCodec.h (~5 bytes per sample), whose
+*           version 2 COMPACT_BINARY_MILLISECONDS keeps the milliseconds
+*           (~6 bytes per sample).
 * 
 *  Created: October 25, 2018
 *   Author: Nuertey Odzeyem        
@@ -45,9 +75,15 @@
 #pragma once
 
 #include <string>
+#include <chrono>
 #include <cstdint>
+#include <span>
+#include <array>
 #include <MQTTClientMbedOs.h>
-#include "Utilities.h"
+#include "mbed.h"
+#include "TCPSocket.h"
+#include "NuerteyDHT11Device.h"
+#include "NuerteyTelemetryCodec.h"
 
 class NuerteyMQTTClient 
 {
@@ -58,8 +94,80 @@ public:
     static const std::string DEFAULT_MQTT_USERNAME;          // Let's not forget authentication as security is important. 
     static const std::string DEFAULT_MQTT_PASSWORD;          // Let's not forget authentication as security is important.
     static const uint32_t    DEFAULT_TIME_TO_WAIT_FOR_RECEIVED_MESSAGE_MSECS = 200;
+    // Short enough for a dead session to be noticed within a minute or so.
+    static constexpr uint16_t KEEPALIVE_INTERVAL_SECONDS = 60;
+
+    // JWT credentials. Signing one costs an ECDSA operation, hence tokens
+    // are reused across reconnects and only re-signed within the renewal
+    // margin of their expiry.
+    static constexpr std::chrono::seconds DEFAULT_JWT_LIFETIME{3600};  // 1 hour.
+    static constexpr std::chrono::seconds JWT_RENEWAL_MARGIN{300};     // 5 minutes.
+
+    // In-flight publish window. Packet identifiers are allocated from the
+    // upper half of the range so as not to collide with the ones that the
+    // Paho client allocates (from 1 upwards) for its own subscriptions.
+    static constexpr size_t      MAXIMUM_INFLIGHT_PUBLISHES  = 4;
+    static constexpr std::chrono::milliseconds PUBACK_TIMEOUT{5000};
+    static constexpr uint8_t     MAXIMUM_PUBLISH_RETRIES     = 3;
+    static constexpr uint16_t    FIRST_INFLIGHT_PACKET_ID    = 0x8000;
+
+    // Topics are copied in with every publish in flight, and the batch's,
+    // so that retransmissions go out on the topic first published to.
+    static constexpr size_t      MAXIMUM_TOPIC_LENGTH        = 63;
+
+    // Invoked with the packet identifier returned by PublishAsync() and 
+    // whether the broker did acknowledge it (before the retries ran out).
+    using PublishCallback_t = mbed::Callback<void(uint16_t, bool)>;
+
+    // Messages on our subscriptions: topic and payload, neither of them
+    // null-terminated, as they lie in the receive buffer. Only valid for
+    // the duration of the call, which is made on the thread driving the
+    // session from within Yield() or ServiceInFlightPublishes().
+    using MessageHandler_t = mbed::Callback<void(const char *, size_t, const char *, size_t)>;
+
+    // Invoked, oldest first, with the samples of a batch that the broker
+    // did acknowledge (true), or else with those that were given up on 
+    // (false): those of a batch left unacknowledged, then those which were
+    // accumulating behind it, or those which never went out by the time 
+    // batching was disabled. Made on the thread driving the session; it
+    // is to requeue the samples, not to publish nor Batch() anew.
+    using BatchCallback_t = mbed::Callback<void(std::span<const CompactReading_t>, bool)>;
+
+    // How a batch topic's payloads are to be formatted.
+    enum class PayloadEncoding_t : uint8_t
+    {
+        JSON_TEXT,
+        COMPACT_BINARY,              // Format version 1, in seconds.
+        COMPACT_BINARY_MILLISECONDS  // Format version 2, in milliseconds.
+    };
+
+    // Fixed header (1) + remaining length (up to 4) + topic length (2) + 
+    // packet identifier (2). The topic itself is accounted for separately.
+    static constexpr size_t  MQTT_PUBLISH_HEADER_OVERHEAD_BYTES = 9;
+    static constexpr size_t  MAXIMUM_PACKET_SIZE_BYTES          = MBED_CONF_MBED_MQTT_MAX_PACKET_SIZE;
+
+    // The most payload that still makes one packet on any topic we accept.
+    static constexpr size_t  MAXIMUM_PAYLOAD_SIZE_BYTES = MAXIMUM_PACKET_SIZE_BYTES 
+                                                        - MQTT_PUBLISH_HEADER_OVERHEAD_BYTES - MAXIMUM_TOPIC_LENGTH;
+
+    // A pooled message owns both its header and its payload bytes. One
+    // slot beyond the in-flight window lets the next message be composed
+    // while the window is full. A payload that fills its slot can always
+    // be sent.
+    struct MessageSlot_t
+    {
+        MQTT::Message                                header;
+        std::array<char, MAXIMUM_PAYLOAD_SIZE_BYTES> payload;
+    };
+
+    static constexpr size_t  MESSAGE_POOL_SLOTS = MAXIMUM_INFLIGHT_PUBLISHES + 1;
+
+    // Samples are kept as well as encoded so that they can be handed back.
+    static constexpr size_t  MAXIMUM_BATCH_SAMPLES = 32;
     
-    NuerteyMQTTClient(const std::string & server, const uint16_t & port);
+    // The socket must outlive the client, and be connected to the broker
+    // before each Connect(); the client closes it as sessions end.
+    NuerteyMQTTClient(TCPSocket * pSocket, const std::string & server, const uint16_t & port);
     
     // TBD, Nuertey Odzeyem : Perhaps add code to detect spurious client 
     // disconnects and logic to reconnect if so, and on the fly.
@@ -75,9 +183,22 @@ public:
     
     virtual ~NuerteyMQTTClient();
 
+    // Authenticate with an ES256-signed JWT in place of the password from
+    // the next Connect() on. Both strings must outlive the client. As the
+    // token is stamped with NTP time, Connect() fails until NTP has
+    // synchronized.
+    void EnableJWTCredentials(const char * audience, const char * privateKey,
+                              const std::chrono::seconds & lifetime = DEFAULT_JWT_LIFETIME);
+
     bool Connect();
     void Disconnect();
 
+    // Unlike Disconnect(), makes no attempt at talking to the broker. The
+    // publishes in flight complete as unacknowledged and the socket is 
+    // closed, ready to be reopened for a subsequent Connect(). Invoked by 
+    // ServiceInFlightPublishes() itself should it detect a broken session.
+    void AbandonSession();
+
     // The Paho MQTT embedded client does not seem to like playing nice 
     // with the null appended to std::string::c_str() so rather use char *.
     void Subscribe(const char * topic);
@@ -87,7 +208,63 @@ public:
     // TBD, Nuertey Odzeyem : Maybe consider replacing pointer and size with mbed::Span. 
     void Publish(const char * topic, const void * data, const size_t & size); 
 
+    // Pipelined QoS1 publish. Returns the packet identifier, or 0 if the
+    // window is full, the topic is longer than MAXIMUM_TOPIC_LENGTH or the
+    // packet could not be sent. The topic is copied but the data must
+    // remain valid until onComplete has been invoked as it may be
+    // retransmitted.
+    [[nodiscard]] uint16_t PublishAsync(const char * topic, const void * data, const size_t & size,
+                                        PublishCallback_t onComplete = nullptr);
+
+    // Pooled messages. Fill in payload and header.payloadlen, then hand
+    // the slot to PublishAsync() which owns it from there on, whatever the
+    // outcome, and waits first for room in the window if need be. Should 
+    // the pool be exhausted, AllocateMessage() services the window until a
+    // slot frees up; nullptr implies that the session has failed.
+    [[nodiscard]] MessageSlot_t * AllocateMessage();
+    void ReleaseMessage(MessageSlot_t * pSlot);
+    [[nodiscard]] uint16_t PublishAsync(const char * topic, MessageSlot_t * pSlot,
+                                        PublishCallback_t onComplete = nullptr);
+
+    // Receive and dispatch whatever arrives within timeInterval (PUBACKs,
+    // PUBLISHes of our subscriptions, PINGRESPs), retransmit timed out 
+    // publishes and keep the session alive. Returns MQTT::FAILURE, having
+    // abandoned the session, if the socket or the broker has gone away.
+    int ServiceInFlightPublishes(const uint32_t & timeInterval = DEFAULT_TIME_TO_WAIT_FOR_RECEIVED_MESSAGE_MSECS);
+
+    // Block until every publish in flight has been completed one way or
+    // another, or the session fails.
+    void WaitForInFlightPublishes();
+
+    size_t GetInFlightPublishesCount() const;
+
+    // Whether a PINGREQ is yet to be answered. Those who would sleep in
+    // between should wait for the PINGRESP as they would for a PUBACK.
+    bool IsAwaitingPingResponse() const { return m_IsAwaitingPingResponse; }
+
+    // Batching mode. Once enabled, Batch() accumulates samples destined
+    // for topic and publishes them as one payload as soon as maximumSamples
+    // (at most MAXIMUM_BATCH_SAMPLES) have accumulated, or the next sample
+    // would overflow the packet. FlushBatchIfDue() should be invoked 
+    // periodically to also enforce maximumAge on sparse batches, and to 
+    // retry a batch that could not go out.
+    void EnableBatching(const char * topic, const size_t & maximumSamples, const std::chrono::milliseconds & maximumAge,
+                        const PayloadEncoding_t & encoding = PayloadEncoding_t::JSON_TEXT);
+    void DisableBatching();
+    void SetBatchCallback(BatchCallback_t onComplete) { m_TheBatchCallback = onComplete; }
+
+    // False if the sample was not taken, i.e. the batch is full and could
+    // not be sent (offline, or the previous batch awaits its PUBACK).
+    [[nodiscard]] bool Batch(const CompactReading_t & reading);
+
+    // False if the batch is still held, to be retried later.
+    bool FlushBatch();
+    void FlushBatchIfDue();
+    bool IsBatching() const { return m_IsBatching; }
+    size_t GetBatchedSampleCount() const { return m_BatchedSampleCount; }
+
     std::string GetHostDomainName() const {return m_MQTTBrokerDomainName;}
+    void        SetHostDomainName(const std::string & server) {m_MQTTBrokerDomainName = server;}
     uint16_t    GetPortNumber() const {return m_MQTTBrokerPort;}     
     bool        IsConnected() const {return m_IsMQTTSessionEstablished;} 
 
@@ -101,12 +278,71 @@ public:
     int Yield(const uint32_t & timeInterval = DEFAULT_TIME_TO_WAIT_FOR_RECEIVED_MESSAGE_MSECS);
  
     static void MessageArrived(MQTT::MessageData & data);
+    static void SetMessageHandler(MessageHandler_t handler) { m_TheMessageHandler = handler; }
         
     static uint64_t              m_ArrivedMessagesCount;
-    static uint64_t              m_OldMessagesCount;
 private:
+    static MessageHandler_t      m_TheMessageHandler;
+
+    struct InFlightPublish_t
+    {
+        uint16_t                  packetId; // 0 marks the slot as free.
+        uint8_t                   retries;
+        Kernel::Clock::time_point sentTime;
+        std::array<char, MAXIMUM_TOPIC_LENGTH + 1> topic;
+        const void *              payload;
+        size_t                    payloadLength;
+        MessageSlot_t *           pSlot;    // If pooled, released on completion.
+        PublishCallback_t         onComplete;
+    };
+
+    [[nodiscard]] int  SerializePublishPacket(const InFlightPublish_t & publish, const bool & isDuplicate);
+    [[nodiscard]] bool SendPacket(const unsigned char * buffer, const int & length);
+    [[nodiscard]] int  ReceivePacket(const uint32_t & timeInterval);
+    [[nodiscard]] bool DiscardPacket(const int & headerLength, int remainingLength);
+    void DispatchPacket(const int & length);
+    void CompleteInFlightPublish(InFlightPublish_t & publish, const bool & acknowledged);
+    void OnBatchPublished(uint16_t packetId, bool acknowledged);
+    void ReturnBatch();
+    [[nodiscard]] bool RefreshJWTIfDue(); // See NuerteyMQTTClientJWT.cpp.
+
     std::string                  m_MQTTBrokerDomainName; // Domain name will always exist.
     uint16_t                     m_MQTTBrokerPort;
+    TCPSocket *                  m_pSocket;
     MQTTClient                   m_PahoMQTTclient;
     bool                         m_IsMQTTSessionEstablished;
+
+    const char *                 m_pJWTAudience;
+    const char *                 m_pJWTPrivateKey;      // nullptr unless JWT credentials are enabled.
+    std::chrono::seconds         m_TheJWTLifetime;
+    std::string                  m_TheJWT;
+    int64_t                      m_TheJWTExpiry;        // Milliseconds since the UNIX epoch.
+
+    std::array<InFlightPublish_t, MAXIMUM_INFLIGHT_PUBLISHES> m_InFlightPublishes;
+    uint16_t                     m_NextPacketId;
+    Kernel::Clock::time_point    m_LastTransmitTime;
+    Kernel::Clock::time_point    m_LastReceiveTime;
+    bool                         m_IsAwaitingPingResponse;
+    std::array<unsigned char, MAXIMUM_PACKET_SIZE_BYTES> m_TransmitBuffer;
+    std::array<unsigned char, MAXIMUM_PACKET_SIZE_BYTES> m_ReceiveBuffer;
+    MemoryPool<MessageSlot_t, MESSAGE_POOL_SLOTS>        m_MessagePool;
+
+    // Batching mode state. The payload buffer is part of the object so
+    // that coalescing samples never touches the heap.
+    bool                         m_IsBatching;
+    std::array<char, MAXIMUM_TOPIC_LENGTH + 1> m_BatchTopic;
+    size_t                       m_MaximumBatchSamples;
+    std::chrono::milliseconds    m_MaximumBatchAge;
+    size_t                       m_BatchPayloadCapacity;
+    size_t                       m_BatchPayloadLength;
+    size_t                       m_BatchedSampleCount;
+    int64_t                      m_BatchBaseTimestamp;  // Epoch milliseconds.
+    int64_t                      m_BatchLastTimestamp;
+    PayloadEncoding_t            m_BatchEncoding;
+    Kernel::Clock::time_point    m_BatchOpenedTime;
+    std::array<char, MAXIMUM_PAYLOAD_SIZE_BYTES> m_BatchPayload;
+    std::array<CompactReading_t, MAXIMUM_BATCH_SAMPLES> m_BatchReadings;
+    std::array<CompactReading_t, MAXIMUM_BATCH_SAMPLES> m_InFlightBatchReadings;
+    size_t                       m_InFlightBatchCount;   // 0 unless a batch awaits its PUBACK.
+    BatchCallback_t              m_TheBatchCallback;
 };
@@ -0,0 +1,45 @@
+#include "NuerteyMQTTClient.h"
+#include "Utilities.h"
+#include "NuerteyLogger.h"
+
+// Apart from the session logic, as signing takes jwt-mbed and the
+// timestamps NTP, neither of which is to be had off-target.
+bool NuerteyMQTTClient::RefreshJWTIfDue()
+{
+    if (!Utility::g_NTPClient.IsSynchronized())
+    {
+        LOG_WARNING("\r\nWarning! JWT credentials await NTP synchronization.\n");
+        return false;
+    }
+
+    const auto now = Utility::g_NTPClient.GetTimestampMilliseconds();
+    const auto renewalMargin = std::chrono::duration_cast<std::chrono::milliseconds>(JWT_RENEWAL_MARGIN).count();
+    if (!m_TheJWT.empty() && ((now + renewalMargin) < m_TheJWTExpiry))
+    {
+        return true;
+    }
+
+    const auto issuedAt = jwt::date(std::chrono::duration_cast<jwt::date::duration>(std::chrono::milliseconds(now)));
+    const auto expiresAt = issuedAt + m_TheJWTLifetime;
+
+    std::error_code errorCode;
+    auto token = jwt::create()
+                     .set_issued_at(issuedAt)
+                     .set_expires_at(expiresAt)
+                     .set_audience(std::string(m_pJWTAudience))
+                     .sign(jwt::algorithm::es256("", m_pJWTPrivateKey), errorCode);
+    if (errorCode)
+    {
+        LOG_ERROR("\r\nError! Failed to sign JWT: [%d] -> %s\n", 
+                  errorCode.value(), errorCode.message().c_str());
+        m_TheJWT.clear();
+        return false;
+    }
+
+    m_TheJWT = std::move(token);
+    m_TheJWTExpiry = now + std::chrono::duration_cast<std::chrono::milliseconds>(m_TheJWTLifetime).count();
+
+    LOG_INFO("\r\nJWT credentials signed, valid for %lld seconds.\n", 
+             static_cast<long long>(m_TheJWTLifetime.count()));
+    return true;
+}
@@ -1,122 +1,315 @@
 #include "NuerteyNTPClient.h"
 #include "Utilities.h"
+#include "NuerteyLogger.h"
+#include "NuerteySpanTracer.h"
 #include "lwip/arch.h"
 #include "lwip/tcp.h"
 #include "lwip/netif.h"
 
-// Virtual cluster of timeservers providing reliable easy to use NTP service for millions of clients.
-const std::string NuerteyNTPClient::DEFAULT_NTP_SERVER_ADDRESS("2.pool.ntp.org");
-
 const uint16_t    NuerteyNTPClient::DEFAULT_NTP_SERVER_PORT;
 const uint16_t    NuerteyNTPClient::DEFAULT_NTP_CLIENT_PORT;
 const uint32_t    NuerteyNTPClient::NTP_VERSUS_UNIX_TIMESTAMP_DELTA;
 
-NuerteyNTPClient::NuerteyNTPClient(NetworkInterface * pNetworkInterface, const std::string & server, const uint16_t & port)
+NuerteyNTPClient::NuerteyNTPClient(NetworkInterface * pNetworkInterface, const std::vector<std::string> & servers,
+                                   const uint16_t & port)
     : m_pNetworkInterface(pNetworkInterface)
-    , m_NTPServerAddress(server)
+    , m_NTPServerAddresses(servers)
     , m_NTPServerPort(port)
+    , m_TheDiscipline{0, 0, 0}
+    , m_IsSynchronized(false)
+    , m_TheFrequency(0)
+    , m_TheLastSyncMonotonic(0)
+    , m_TheLastSample{0, 0}
+    , m_TheFirstStepBoundary(0)
+    , m_TheFirstStepAmount(0)
+    , m_TheFormatter()
+    , m_TheTimestampText{}
+    , m_pTheEventQueue(nullptr)
+    , m_TheResynchronizationEventId(0)
+    , m_TheResynchronizationPeriod(DEFAULT_RESYNCHRONIZATION_PERIOD)
+{
+    if (m_NTPServerAddresses.empty())
+    {
+        m_NTPServerAddresses.assign(DEFAULT_NTP_SERVER_ADDRESSES.begin(), DEFAULT_NTP_SERVER_ADDRESSES.end());
+    }
+}
+
+bool NuerteyNTPClient::SynchronizeRTCTimestamp()
+{
+    // Deep sleep unclocks the Ethernet MAC, and the responses with it.
+    DeepSleepLock lock;
+
+    if (!m_IsSynchronized)
+    {
+        // Until the first round, timestamps are only as good as the RTC.
+        m_TheDiscipline = Discipline_t{static_cast<int64_t>(time(NULL)) * 1'000'000, GetMonotonicMicroseconds(), 0};
+
+        m_TheFormatter.Format(m_TheTimestampText, GetTimestampMilliseconds());
+        LOG_INFO("\r\n\r\nDefault date and time before NTP is :-> [%s]\r\n", m_TheTimestampText.data());
+    }
+
+    Sample_t best{0, 0};
+    bool isAnySample = false;
+
+    for (const auto & server : m_NTPServerAddresses)
+    {
+        [[maybe_unused]] auto isAnswered = QueryServer(server, best, isAnySample);
+    }
+
+    if (!isAnySample)
+    {
+        LOG_WARNING("\r\nWarning! No NTP server answered; timestamps remain %s.\r\n",
+                    m_IsSynchronized ? "extrapolated" : "unsynchronized");
+        return false;
+    }
+
+    Discipline(best);
+
+    LOG_INFO("\r\nNTP offset [%lld] us, delay [%lld] us, drift [%ld] ppb.",
+             static_cast<long long>(best.offset), static_cast<long long>(best.delay),
+             static_cast<long>(m_TheFrequency));
+    m_TheFormatter.Format(m_TheTimestampText, GetTimestampMilliseconds());
+    LOG_INFO("\r\n\r\nSynchronized date and time after NTP is :-> [%s]\r\n", m_TheTimestampText.data());
+
+    return true;
+}
+
+void NuerteyNTPClient::StartPeriodicSynchronization(events::EventQueue * pEventQueue, const std::chrono::seconds & period)
+{
+    StopPeriodicSynchronization();
+
+    m_pTheEventQueue = pEventQueue;
+    m_TheResynchronizationPeriod = period;
+    m_TheResynchronizationEventId = m_pTheEventQueue->call_every(period, [this]()
+    {
+        ScopedKernelSpan span(Span_t::NTP_SYNC);
+        [[maybe_unused]] auto isSynchronized = SynchronizeRTCTimestamp();
+    });
+}
+
+void NuerteyNTPClient::StopPeriodicSynchronization()
 {
+    if (m_pTheEventQueue && m_TheResynchronizationEventId)
+    {
+        m_pTheEventQueue->cancel(m_TheResynchronizationEventId);
+    }
+    m_TheResynchronizationEventId = 0;
 }
 
-void NuerteyNTPClient::SynchronizeRTCTimestamp()
+int64_t NuerteyNTPClient::GetTimestampMicroseconds() const
 {
-    Utility::g_STDIOMutex.lock();
-    printf("\r\n\r\nDefault date and time before NTP is :-> [%s UTC]\r\n", Utility::WhatTimeNow().c_str());
-    Utility::g_STDIOMutex.unlock();
-
-    struct NTPPacket pkt;
-
-    pkt.li = 3; // Leap Indicator : "clock not synchronized"; Only significant in server messages.
-    pkt.vn = 4; // Version Number : "NTP/SNTP version 4"
-    pkt.mode = 3; // Mode : "Client"
-    pkt.stratum = 0; // Stratum. Significant only in SNTP server messages.
-    pkt.poll = 0; // Poll Interval. Significant only in SNTP server messages.
-    pkt.precision = 0; // Precision. Significant only in server messages.
-    pkt.rootDelay = 0; // Root Delay. Significant only in server messages.
-    pkt.rootDispersion = 0; // Root Dispersion. Significant only in server messages.
-    pkt.refId = 0; // Reference Identifier. Significant only in server messages.
-    pkt.refTm_s = 0; // Reference Timestamp. Significant only in server messages.
-    pkt.origTm_s = 0; // Originate Timestamp. Significant only in server messages.
-    pkt.rxTm_s = 0; // Receive Timestamp. Significant only in server messages.
-    pkt.txTm_s = htonl(NTP_VERSUS_UNIX_TIMESTAMP_DELTA + time(NULL)); // WARN: We are in LE format, network byte order is BE
-    pkt.refTm_f = pkt.origTm_f = pkt.rxTm_f = pkt.txTm_f = 0;
+    core_util_critical_section_enter();
+    const auto discipline = m_TheDiscipline;
+    core_util_critical_section_exit();
 
+    if (!m_IsSynchronized && (discipline.baseMonotonic == 0))
+    {
+        return (static_cast<int64_t>(time(NULL)) * 1'000'000);
+    }
+
+    return ToUTCMicroseconds(discipline, GetMonotonicMicroseconds());
+}
+
+bool NuerteyNTPClient::QueryServer(const std::string & server, Sample_t & best, bool & isAnySample)
+{
     SocketAddress serverSocketAddress;
-    SocketAddress clientSocketAddress;
 
-    nsapi_size_or_error_t retVal;
-    do
+    LOG_INFO("\r\nPerforming DNS lookup for : \"%s\" ...", server.c_str());
+    nsapi_size_or_error_t retVal = m_pNetworkInterface->gethostbyname(server.c_str(), &serverSocketAddress);
+    if (retVal < 0)
     {
-        printf("\r\nPerforming DNS lookup for : \"%s\" ...", m_NTPServerAddress.c_str());
-        retVal = m_pNetworkInterface->gethostbyname(m_NTPServerAddress.c_str(), &serverSocketAddress);
-        if (retVal < 0)
-        {
-            printf("\r\nError! On DNS lookup, Network returned: [%d] -> %s", retVal, ToString(retVal).c_str());
-        }
+        LOG_ERROR("\r\nError! On DNS lookup, Network returned: [%d] -> %s", retVal, ToString(retVal).c_str());
+        return false;
     }
-    while (retVal < 0);
 
     serverSocketAddress.set_port(m_NTPServerPort);
 
     UDPSocket sock;
-    sock.bind(DEFAULT_NTP_CLIENT_PORT);
-    sock.set_blocking(false);
-    sock.set_timeout(BLOCKING_SOCKET_TIMEOUT_MILLISECONDS); // Set timeout as we are on embedded.
+    retVal = sock.open(m_pNetworkInterface);
+    if (retVal < 0)
+    {
+        LOG_ERROR("\r\nError! UDPSocket.open() returned: [%d] -> %s", retVal, ToString(retVal).c_str());
+        return false;
+    }
 
-    sock.open(m_pNetworkInterface);
+    sock.bind(DEFAULT_NTP_CLIENT_PORT);
+    sock.set_timeout(NTP_RESPONSE_TIMEOUT_MILLISECONDS); // Set timeout as we are on embedded.
 
-    printf("\r\nPinging NTP Time Server at : \"%s\" ...", serverSocketAddress.get_ip_address());
-    sock.sendto(serverSocketAddress, static_cast<void *>(&pkt), sizeof(NTPPacket));
+    bool isAnswered = false;
 
-    do
+    for (uint8_t i = 0; i < NTP_SAMPLES_PER_SERVER; i++)
     {
-        printf("\r\nWaiting for NTP Time Server response ...");
-        nsapi_size_or_error_t status = sock.recvfrom(&clientSocketAddress, static_cast<void *>(&pkt), sizeof(NTPPacket));
-        printf("\r\nReceived a response from : \"%s\" .", clientSocketAddress.get_ip_address());
+        struct NTPPacket pkt{};
+
+        pkt.li = 3; // Leap Indicator : "clock not synchronized"; Only significant in server messages.
+        pkt.vn = 4; // Version Number : "NTP/SNTP version 4"
+        pkt.mode = 3; // Mode : "Client"
+
+        core_util_critical_section_enter();
+        const auto discipline = m_TheDiscipline;
+        core_util_critical_section_exit();
 
-        if (status < (nsapi_size_or_error_t)sizeof(NTPPacket))
+        // The server echoes our transmit timestamp back as its originate
+        // timestamp, which tells its answer apart from any stale one.
+        uint32_t originate_s = 0;
+        uint32_t originate_f = 0;
+        const auto t1 = GetMonotonicMicroseconds();
+        ToNTPTimestamp(ToUTCMicroseconds(discipline, t1), originate_s, originate_f);
+        pkt.txTm_s = htonl(originate_s); // WARN: We are in LE format, network byte order is BE
+        pkt.txTm_f = htonl(originate_f);
+
+        LOG_DEBUG("\r\nPinging NTP Time Server at : \"%s\" ...", serverSocketAddress.get_ip_address());
+        if (sock.sendto(serverSocketAddress, static_cast<void *>(&pkt), sizeof(NTPPacket)) < 0)
+        {
+            continue;
+        }
+
+        // Bounded by the response timeout, however many strays arrive.
+        while ((GetMonotonicMicroseconds() - t1) < (NTP_RESPONSE_TIMEOUT_MILLISECONDS * 1000))
         {
+            SocketAddress clientSocketAddress;
+            nsapi_size_or_error_t status = sock.recvfrom(&clientSocketAddress, static_cast<void *>(&pkt), sizeof(NTPPacket));
+            const auto t4 = GetMonotonicMicroseconds();
+
             if (status < 0)
             {
-                printf("\r\nError! Socket recvfrom returned: [%d] -> %s", status, ToString(status).c_str());
+                LOG_WARNING("\r\nWarning! NTP Time Server \"%s\" did not answer: [%d] -> %s",
+                            server.c_str(), status, ToString(status).c_str());
+                break;
             }
-            else
+
+            if ((status < static_cast<nsapi_size_or_error_t>(sizeof(NTPPacket)))
+                || (clientSocketAddress != serverSocketAddress)
+                || (ntohl(pkt.origTm_s) != originate_s) || (ntohl(pkt.origTm_f) != originate_f))
             {
-                printf("\r\nError! Partial data returned on socket read: [%d]", status);
+                continue;
+            }
+
+            if (pkt.stratum == 0)  // "kiss-o'-death message"
+            {
+                LOG_WARNING("\r\nWarning! Received a kiss-o'-death message from \"%s\".", server.c_str());
+                sock.close();
+                return isAnswered;
             }
-        }
 
-        // TBD, Nuertey Odzeyem : we would need a DNS Resolver to be able to compare the incoming address with the DNS name.
+            // Compute offset and delay, see RFC 4330 p.13
+            const auto T1 = ToUTCMicroseconds(discipline, t1);
+            const auto T2 = FromNTPTimestamp(ntohl(pkt.rxTm_s), ntohl(pkt.rxTm_f));
+            const auto T3 = FromNTPTimestamp(ntohl(pkt.txTm_s), ntohl(pkt.txTm_f));
+            const auto T4 = ToUTCMicroseconds(discipline, t4);
+
+            const Sample_t sample{((T2 - T1) + (T3 - T4)) / 2, (T4 - T1) - (T3 - T2)};
+
+            if ((sample.delay >= 0) && (!isAnySample || (sample.delay < best.delay)))
+            {
+                best = sample;
+                isAnySample = true;
+            }
+            isAnswered = true;
+            break;
+        }
     }
-    while (strcmp(serverSocketAddress.get_ip_address(), clientSocketAddress.get_ip_address()) != 0);
 
-    if (pkt.stratum == 0)  // "kiss-o'-death message"
+    sock.close();
+    return isAnswered;
+}
+
+void NuerteyNTPClient::Discipline(const Sample_t & sample)
+{
+    const auto now = GetMonotonicMicroseconds();
+
+    core_util_critical_section_enter();
+    auto discipline = m_TheDiscipline;
+    core_util_critical_section_exit();
+
+    const auto utc = ToUTCMicroseconds(discipline, now);
+    const auto magnitude = (sample.offset < 0) ? -sample.offset : sample.offset;
+
+    if (!m_IsSynchronized || (magnitude > STEP_THRESHOLD_MICROSECONDS))
     {
-        printf("\r\nReceived a kiss-o'-death message.");
+        // Step. The frequency estimate, if any, still holds.
+        discipline = Discipline_t{utc + sample.offset, now, m_TheFrequency};
+        set_time(static_cast<time_t>(discipline.baseUTC / 1'000'000));
+
+        if (!m_IsSynchronized && (sample.offset >= 1'000'000))
+        {
+            m_TheFirstStepBoundary = utc / 1000;
+            m_TheFirstStepAmount = (sample.offset + 500) / 1000;
+        }
     }
     else
     {
-        // Correct for Endianness ...
-        pkt.refTm_s = ntohl(pkt.refTm_s);
-        pkt.refTm_f = ntohl(pkt.refTm_f);
-        pkt.origTm_s = ntohl(pkt.origTm_s);
-        pkt.origTm_f = ntohl(pkt.origTm_f);
-        pkt.rxTm_s = ntohl(pkt.rxTm_s);
-        pkt.rxTm_f = ntohl(pkt.rxTm_f);
-        pkt.txTm_s = ntohl(pkt.txTm_s);
-        pkt.txTm_f = ntohl(pkt.txTm_f);
-
-        // Compute offset, see RFC 4330 p.13
-        uint32_t destTm_s = (NTP_VERSUS_UNIX_TIMESTAMP_DELTA + time(NULL));
-        int64_t offset = ((int64_t)(pkt.rxTm_s - pkt.origTm_s) + (int64_t)(pkt.txTm_s - destTm_s)) / 2; // Avoid overflow
-        printf("\r\nServer deduced that client transmitted this timestamp: [%lu]", pkt.txTm_s);
-        printf("\r\nCalculated system clock offset: [%lld]", offset);
-
-        // Seed the RTC accordingly...
-        set_time(time(NULL) + offset);
-
-        printf("\r\n\r\nSynchronized date and time after NTP is :-> [%s UTC]\r\n", Utility::WhatTimeNow().c_str());
+        // The previous offset was slewed out in the meantime; whatever
+        // remains is down to frequency error. Half of it is corrected per
+        // round so as to average out the network's jitter.
+        const auto interval = now - m_TheLastSyncMonotonic;
+        if (interval > 0)
+        {
+            const auto error = (sample.offset * 1'000'000'000) / interval;
+            m_TheFrequency = static_cast<int32_t>(std::clamp<int64_t>(m_TheFrequency + (error / 2),
+                                                                      -MAXIMUM_DRIFT_PPB, MAXIMUM_DRIFT_PPB));
+        }
+
+        // And this offset is slewed out over the next period, continuously.
+        const auto period = std::chrono::duration_cast<std::chrono::microseconds>(m_TheResynchronizationPeriod).count();
+        const auto slew = (sample.offset * 1'000'000'000) / period;
+        discipline = Discipline_t{utc, now, static_cast<int32_t>(m_TheFrequency + slew)};
+
+        // The RTC, and hence time(NULL), need only be within the second.
+        const auto seconds = static_cast<time_t>(utc / 1'000'000);
+        if (time(NULL) != seconds)
+        {
+            set_time(seconds);
+        }
     }
 
-    sock.close();
+    core_util_critical_section_enter();
+    m_TheDiscipline = discipline;
+    core_util_critical_section_exit();
+
+    m_TheLastSyncMonotonic = now;
+    m_TheLastSample = sample;
+    m_IsSynchronized.store(true, std::memory_order_release);
+}
+
+int64_t NuerteyNTPClient::CorrectPreSynchronizationMilliseconds(const int64_t & timestamp) const
+{
+    // Timestamps taken since the step are all beyond the boundary.
+    if (IsSynchronized() && (timestamp <= m_TheFirstStepBoundary))
+    {
+        return (timestamp + m_TheFirstStepAmount);
+    }
+
+    return timestamp;
+}
+
+int64_t NuerteyNTPClient::GetMonotonicMicroseconds()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Kernel::Clock::now().time_since_epoch()).count();
+}
+
+int64_t NuerteyNTPClient::ToUTCMicroseconds(const Discipline_t & discipline, const int64_t & monotonic)
+{
+    const auto elapsed = monotonic - discipline.baseMonotonic;
+    return (discipline.baseUTC + elapsed + ((elapsed * discipline.rate) / 1'000'000'000));
+}
+
+int64_t NuerteyNTPClient::FromNTPTimestamp(const uint32_t & seconds, const uint32_t & fraction)
+{
+    auto unixSeconds = static_cast<int64_t>(seconds) - NTP_VERSUS_UNIX_TIMESTAMP_DELTA;
+
+    // Era 1 begins in February 2036; timestamps with their most significant
+    // bit clear are taken to be from it (RFC 4330, Section 3).
+    if (!(seconds & 0x80000000))
+    {
+        unixSeconds += (INT64_C(1) << 32);
+    }
+
+    return ((unixSeconds * 1'000'000) + static_cast<int64_t>((static_cast<uint64_t>(fraction) * 1'000'000) >> 32));
+}
+
+void NuerteyNTPClient::ToNTPTimestamp(const int64_t & utc, uint32_t & seconds, uint32_t & fraction)
+{
+    seconds = static_cast<uint32_t>((utc / 1'000'000) + NTP_VERSUS_UNIX_TIMESTAMP_DELTA);
+    fraction = static_cast<uint32_t>((static_cast<uint64_t>(utc % 1'000'000) << 32) / 1'000'000);
 }
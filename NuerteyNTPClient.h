@@ -1,33 +1,63 @@
 /***********************************************************************
 * @file
 *
-* My version of an NTP Client that synchronizes ARM Mbed-enabled target 
+* My version of an NTP Client that synchronizes ARM Mbed-enabled target
 * RTCs to a remote time server over UDP. Consult RFC 4330 for reference.
-*       
-* @note      
-* 
-* @warning  
-* 
+*
+* @note     Each synchronization round queries every configured server a
+*           few times and keeps the one sample of least round-trip delay,
+*           as that is the one least skewed by path asymmetry. Offset and
+*           delay are computed per RFC 4330 in microseconds, fractions of
+*           a second included.
+*
+*           Between rounds, timestamps are extrapolated from Kernel::Clock
+*           at the drift rate measured over the previous rounds. Small
+*           offsets are slewed out over the next resynchronization period
+*           so that timestamps never step backwards; only the first round,
+*           or an offset beyond STEP_THRESHOLD_MICROSECONDS, steps the
+*           clock (and the RTC).
+*
+* @warning  A round blocks its caller for up to servers x samples x
+*           NTP_RESPONSE_TIMEOUT_MILLISECONDS, plus DNS lookups.
+*
 *  Created: October 19, 2018
-*   Author: Nuertey Odzeyem        
+*   Author: Nuertey Odzeyem
 ************************************************************************/
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string>
+#include <vector>
+#include <chrono>
 #include <cstdint>
+#include "mbed.h"
+#include "mbed_events.h"
 #include "NetworkInterface.h"
+#include "NuerteyTimestampFormatter.h"
 
-class NuerteyNTPClient 
+class NuerteyNTPClient
 {
-    static const std::string DEFAULT_NTP_SERVER_ADDRESS;
+    // Virtual cluster of timeservers providing reliable easy to use NTP
+    // service for millions of clients. Literals, so as to be constant
+    // initialized ahead of any global client.
+    static constexpr std::array<const char *, 4> DEFAULT_NTP_SERVER_ADDRESSES{
+        "0.pool.ntp.org", "1.pool.ntp.org", "2.pool.ntp.org", "3.pool.ntp.org"};
     static const uint16_t    DEFAULT_NTP_SERVER_PORT          =  123;
     static const uint16_t    DEFAULT_NTP_CLIENT_PORT          =  0; // Signifying a random port.
-    
-    static constexpr int32_t BLOCKING_SOCKET_TIMEOUT_MILLISECONDS{60000};
-    
+
+    static constexpr int32_t NTP_RESPONSE_TIMEOUT_MILLISECONDS{1000};
+    static constexpr uint8_t NTP_SAMPLES_PER_SERVER           =  2;
+
     // Difference between a UNIX timestamp (Starting Jan, 1st 1970) and a NTP timestamp (Starting Jan, 1st 1900)
     static const uint32_t    NTP_VERSUS_UNIX_TIMESTAMP_DELTA  =  2208988800ull;
 
+    // As with ntpd; anything less is slewed out rather than stepped.
+    static constexpr int64_t STEP_THRESHOLD_MICROSECONDS      =  128'000;
+
+    // Crystals are good for a few tens of ppm; anything beyond is noise.
+    static constexpr int32_t MAXIMUM_DRIFT_PPB                =  500'000;
+
     struct NTPPacket // See RFC 4330 for Simple NTP
     {
     // WARNING: We are in Little-Endian! Network is Big-Endian!
@@ -54,15 +84,79 @@ class NuerteyNTPClient
     uint32_t txTm_s;
     uint32_t txTm_f;
     } __attribute__ ((packed));
-  
+
+    struct Sample_t
+    {
+        int64_t offset;     // Microseconds, server less local.
+        int64_t delay;      // Microseconds, round trip less server processing.
+    };
+
+    // UTC(t) = baseUTC + (t - baseMonotonic) * (1 + rate)
+    struct Discipline_t
+    {
+        int64_t baseUTC;        // Microseconds since the UNIX epoch.
+        int64_t baseMonotonic;  // Microseconds of Kernel::Clock.
+        int32_t rate;           // Parts per billion.
+    };
+
 public:
-    NuerteyNTPClient(NetworkInterface * pNetworkInterface, const std::string & server = DEFAULT_NTP_SERVER_ADDRESS, 
-          const uint16_t & port = DEFAULT_NTP_SERVER_PORT);
-    
-    void SynchronizeRTCTimestamp();
+    static constexpr std::chrono::seconds DEFAULT_RESYNCHRONIZATION_PERIOD{1024}; // NTP's default maximum poll interval.
+
+    // No servers means DEFAULT_NTP_SERVER_ADDRESSES.
+    NuerteyNTPClient(NetworkInterface * pNetworkInterface,
+                     const std::vector<std::string> & servers = {},
+                     const uint16_t & port = DEFAULT_NTP_SERVER_PORT);
+
+    // One synchronization round; false should no server have answered.
+    bool SynchronizeRTCTimestamp();
+
+    // Further rounds every period from pEventQueue, whose dispatching
+    // thread each round blocks.
+    void StartPeriodicSynchronization(events::EventQueue * pEventQueue,
+                                      const std::chrono::seconds & period = DEFAULT_RESYNCHRONIZATION_PERIOD);
+    void StopPeriodicSynchronization();
+
+    // Thread-safe, monotonic (barring steps) and millisecond-grade.
+    int64_t GetTimestampMicroseconds() const;
+    int64_t GetTimestampMilliseconds() const { return (GetTimestampMicroseconds() / 1000); }
+
+    bool    IsSynchronized() const { return m_IsSynchronized.load(std::memory_order_acquire); }
+    int32_t GetDriftPPB() const { return m_TheFrequency; }
+    int64_t GetLastOffsetMicroseconds() const { return m_TheLastSample.offset; }
+    int64_t GetLastDelayMicroseconds() const { return m_TheLastSample.delay; }
+
+    // Carries epoch milliseconds taken before the first round over to NTP
+    // time. Only a forward first step (i.e. an RTC that was unset, as after 
+    // power loss) can be told apart this way; anything else is returned
+    // as is.
+    int64_t CorrectPreSynchronizationMilliseconds(const int64_t & timestamp) const;
 
 private:
-    NetworkInterface *    m_pNetworkInterface;
-    std::string           m_NTPServerAddress;
-    uint16_t              m_NTPServerPort;
+    bool QueryServer(const std::string & server, Sample_t & best, bool & isAnySample);
+    void Discipline(const Sample_t & sample);
+
+    static int64_t GetMonotonicMicroseconds();
+    static int64_t ToUTCMicroseconds(const Discipline_t & discipline, const int64_t & monotonic);
+    static int64_t FromNTPTimestamp(const uint32_t & seconds, const uint32_t & fraction);
+    static void    ToNTPTimestamp(const int64_t & utc, uint32_t & seconds, uint32_t & fraction);
+
+    NetworkInterface *        m_pNetworkInterface;
+    std::vector<std::string>  m_NTPServerAddresses;
+    uint16_t                  m_NTPServerPort;
+
+    Discipline_t              m_TheDiscipline;
+    std::atomic<bool>         m_IsSynchronized;
+    int32_t                   m_TheFrequency;           // Drift estimate, parts per billion.
+    int64_t                   m_TheLastSyncMonotonic;
+    Sample_t                  m_TheLastSample;
+    int64_t                   m_TheFirstStepBoundary;   // Epoch milliseconds just as the first round stepped.
+    int64_t                   m_TheFirstStepAmount;     // Milliseconds, positive steps only.
+
+    // Rounds are only ever run by one thread at a time.
+    TimestampFormatter        m_TheFormatter;
+    std::array<char, TimestampFormatter::ISO8601_LENGTH + 1> m_TheTimestampText;
+
+    events::EventQueue *      m_pTheEventQueue;
+    int                       m_TheResynchronizationEventId;
+    std::chrono::seconds      m_TheResynchronizationPeriod;
 };
@@ -0,0 +1,155 @@
+/***********************************************************************
+* @file      NuerteyNetworkErrors.h
+*
+*    Descriptions of the network stack's and of the MQTT client's error
+*    codes, and the socket timeout that both are used with.
+*
+* @brief   Split out of Utilities.h so that NuerteyMQTTClient need not
+*          drag in the rest of the application along with them.
+*
+* @warning   Include nothing from mbed but nsapi_types.h, for which
+*            host/shims has a stand-in that host/MQTTThroughput.cpp uses.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include "nsapi_types.h"
+
+// 1 minute of failing to exchange packets with the Broker ought
+// to be enough to tell us that there is something wrong with the socket.
+static constexpr int32_t BLOCKING_SOCKET_TIMEOUT_MILLISECONDS{60000};
+
+enum class MQTTConnectionError_t : int8_t
+{
+    SUCCESS_NO_ERROR                 = 0,
+    UNACCEPTABLE_PROTOCOL_VERSION    = 1,
+    IDENTIFIER_REJECTED              = 2,
+    SERVER_UNAVAILABLE               = 3,
+    BAD_USER_NAME_OR_PASSWORD        = 4,
+    NOT_AUTHORIZED                   = 5,
+    RESERVED                         = 6,
+    MQTTCLIENT_FAILURE               = -1,
+    MQTTCLIENT_DISCONNECTED          = -3,
+    MQTTCLIENT_MAX_MESSAGES_INFLIGHT = -4,
+    MQTTCLIENT_BAD_UTF8_STRING       = -5,
+    MQTTCLIENT_NULL_PARAMETER        = -6,
+    MQTTCLIENT_TOPICNAME_TRUNCATED   = -7,
+    MQTTCLIENT_BAD_STRUCTURE         = -8,
+    MQTTCLIENT_BAD_QOS               = -9,
+    MQTTCLIENT_SSL_NOT_SUPPORTED     = -10,
+    MQTTCLIENT_BAD_MQTT_VERSION      = -11,
+    MQTTCLIENT_BAD_PROTOCOL          = -14,
+    MQTTCLIENT_BAD_MQTT_OPTION       = -15,
+    MQTTCLIENT_WRONG_MQTT_VERSION    = -16
+};
+
+using MQTTConnectionErrorMap_t = std::map<MQTTConnectionError_t, std::string>;
+using IndexElementMQTT_t       = MQTTConnectionErrorMap_t::value_type;
+
+inline static auto make_mqtt_connection_error_map()
+{
+    MQTTConnectionErrorMap_t eMap;
+    
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::SUCCESS_NO_ERROR, std::string("\"Connection succeeded: no errors\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::UNACCEPTABLE_PROTOCOL_VERSION, std::string("\"Connection refused: Unacceptable protocol version\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::IDENTIFIER_REJECTED, std::string("\"Connection refused: Identifier rejected\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::SERVER_UNAVAILABLE, std::string("\"Connection refused: Server unavailable\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::BAD_USER_NAME_OR_PASSWORD, std::string("\"Connection refused: Bad user name or password\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::NOT_AUTHORIZED, std::string("\"Connection refused: Not authorized\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::RESERVED, std::string("\"Reserved for future use\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_FAILURE, std::string("\"Generic MQTT client operation failure\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_DISCONNECTED, std::string("\"The client is disconnected.\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_MAX_MESSAGES_INFLIGHT, std::string("\"The maximum number of messages allowed to be simultaneously in-flight has been reached.\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_UTF8_STRING, std::string("\"An invalid UTF-8 string has been detected.\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_NULL_PARAMETER, std::string("\"A NULL parameter has been supplied when this is invalid.\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_TOPICNAME_TRUNCATED, std::string("\"The topic has been truncated (the topic string includes embedded NULL characters). String functions will not access the full topic. Use the topic length value to access the full topic.\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_STRUCTURE, std::string("\"A structure parameter does not have the correct eyecatcher and version number.\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_QOS, std::string("\"A QoS value that falls outside of the acceptable range (0,1,2)\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_SSL_NOT_SUPPORTED, std::string("\"Attempting SSL connection using non-SSL version of library\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_MQTT_VERSION, std::string("\"unrecognized MQTT version\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_PROTOCOL, std::string("\"protocol prefix in serverURI should be tcp:// or ssl://\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_MQTT_OPTION, std::string("\"option not applicable to the requested version of MQTT\"")));
+    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_WRONG_MQTT_VERSION, std::string("\"call not applicable to the requested version of MQTT\"")));
+
+    return eMap;
+}
+
+static MQTTConnectionErrorMap_t gs_MQTTConnectionErrorMap_t = make_mqtt_connection_error_map();
+
+inline std::string ToString(const MQTTConnectionError_t & key)
+{    
+    std::string result;
+
+    // Prevent the possibility of std::out_of_range exception if the container
+    // does not have an error element with the specified key.
+    auto iter = gs_MQTTConnectionErrorMap_t.find(key);     
+    if (iter != gs_MQTTConnectionErrorMap_t.end())
+    {
+        result = iter->second;
+    }
+    else
+    {
+        result = std::string("\"Warning! Code does not indicate an error and consequently does not exist in gs_MQTTConnectionErrorMap_t!\"");
+    }
+    
+    return result;
+}
+
+using ErrorCodesMap_t = std::map<nsapi_size_or_error_t, std::string>;
+using IndexElement_t  = ErrorCodesMap_t::value_type;
+
+inline static auto make_error_codes_map()
+{
+    ErrorCodesMap_t eMap;
+    
+    eMap.insert(IndexElement_t(NSAPI_ERROR_OK, std::string("\"no error\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_WOULD_BLOCK, std::string("\"no data is not available but call is non-blocking\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_UNSUPPORTED, std::string("\"unsupported functionality\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_PARAMETER, std::string("\"invalid configuration\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_CONNECTION, std::string("\"not connected to a network\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_SOCKET, std::string("\"socket not available for use\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_ADDRESS, std::string("\"IP address is not known\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_MEMORY, std::string("\"memory resource not available\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_SSID, std::string("\"ssid not found\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_DNS_FAILURE, std::string("\"DNS failed to complete successfully\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_DHCP_FAILURE, std::string("\"DHCP failed to complete successfully\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_AUTH_FAILURE, std::string("\"connection to access point failed\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_DEVICE_ERROR, std::string("\"failure interfacing with the network processor\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_IN_PROGRESS, std::string("\"operation (eg connect) in progress\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_ALREADY, std::string("\"operation (eg connect) already in progress\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_IS_CONNECTED, std::string("\"socket is already connected\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_CONNECTION_LOST, std::string("\"connection lost\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_CONNECTION_TIMEOUT, std::string("\"connection timed out\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_ADDRESS_IN_USE, std::string("\"Address already in use\"")));
+    eMap.insert(IndexElement_t(NSAPI_ERROR_TIMEOUT, std::string("\"operation timed out\"")));    
+    return eMap;
+}
+
+static ErrorCodesMap_t gs_ErrorCodesMap = make_error_codes_map();
+
+inline std::string ToString(const nsapi_size_or_error_t & key)
+{
+    std::string result;
+
+    // Prevent the possibility of std::out_of_range exception if the container
+    // does not have an error element with the specified key.
+    auto iter = gs_ErrorCodesMap.find(key);     
+    if (iter != gs_ErrorCodesMap.end())
+    {
+        result = iter->second;
+    }
+    else
+    {
+        result = std::string("\"Warning! Code does not indicate an error and consequently does not exist in gs_ErrorCodesMap!\"");
+    }
+    
+    return result;
+}
@@ -0,0 +1,296 @@
+/***********************************************************************
+* @file      NuerteyReadingsAggregator.h
+*
+*    Incremental, on-device summaries of the sensor readings over a
+*    sliding time window, i.e. the past 1 minute, 15 minutes or 1 hour.
+*
+* @brief   Keep the minimum, maximum, mean, standard deviation and an
+*          exponentially weighted moving average of both channels up to
+*          date in O(1) (amortized) per reading, so that trends can be
+*          published at a fraction of the raw sampling rate instead of
+*          being reduced by every consumer from thousands of messages.
+*
+* @note    - Mean and variance are maintained with Welford's algorithm,
+*            run forwards as readings enter the window and backwards as
+*            they leave it. Doubles keep the round-off of that reversal
+*            well below the sensor's 0.1 resolution.
+*          - Minimum and maximum are the fronts of monotonic deques of the
+*            readings still in the window.
+*          - The EWMA's time constant is the window's duration. Its weight
+*            is derived from the actual time between readings so that
+*            missed readings do not skew it.
+*
+*          Readings are evicted by age rather than count, so that gaps in
+*          acquisition shrink the window's population rather than stretch
+*          its span. CAPACITY should therefore cover the window duration
+*          at the sampling period; any excess is evicted oldest first.
+*
+* @warning   Memory is 16 bytes per reading of CAPACITY, i.e. ~19 KB for
+*            an hour's worth at a 3 seconds sampling period. Standard C++
+*            only, as host/AggregatorCheck.cpp checks it on a workstation.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+
+namespace Aggregation
+{
+    struct ChannelStatistics_t
+    {
+        int16_t  minimum_x10;       // Tenths, as per CompactReading_t.
+        int16_t  maximum_x10;
+        float    mean;              // Whole units from here on.
+        float    standardDeviation; // Sample, i.e. over (count - 1).
+        float    ewma;
+    };
+
+    struct Summary_t
+    {
+        uint32_t            windowSeconds;
+        time_t              timestamp;  // Of the newest reading within.
+        uint16_t            count;
+        ChannelStatistics_t temperature;
+        ChannelStatistics_t humidity;
+    };
+
+    template <size_t N>
+    class MonotonicDeque
+    {
+    public:
+        bool     Empty() const { return (m_Size == 0); }
+        uint16_t Front() const { return m_Positions[m_Front]; }
+        uint16_t Back() const { return m_Positions[(m_Front + m_Size - 1) % N]; }
+        void     PopFront() { m_Front = (m_Front + 1) % N; --m_Size; }
+        void     PopBack() { --m_Size; }
+        void     PushBack(const uint16_t & position) { m_Positions[(m_Front + m_Size++) % N] = position; }
+        void     Clear() { m_Front = 0; m_Size = 0; }
+
+    private:
+        std::array<uint16_t, N> m_Positions{};
+        size_t                  m_Front{0};
+        size_t                  m_Size{0};
+    };
+
+    class Welford
+    {
+    public:
+        void Add(const double & x)
+        {
+            ++m_Count;
+            const auto delta = x - m_Mean;
+            m_Mean += delta / m_Count;
+            m_M2 += delta * (x - m_Mean);
+        }
+
+        void Remove(const double & x)
+        {
+            if (m_Count <= 1)
+            {
+                Clear();
+                return;
+            }
+
+            --m_Count;
+            const auto delta = x - m_Mean;
+            m_Mean -= delta / m_Count;
+            m_M2 = std::max(0.0, m_M2 - (delta * (x - m_Mean)));
+        }
+
+        void   Clear() { m_Count = 0; m_Mean = 0.0; m_M2 = 0.0; }
+        double GetMean() const { return m_Mean; }
+        double GetStandardDeviation() const { return (m_Count > 1) ? std::sqrt(m_M2 / (m_Count - 1)) : 0.0; }
+
+    private:
+        size_t m_Count{0};
+        double m_Mean{0.0};
+        double m_M2{0.0};
+    };
+} // namespace Aggregation
+
+template <size_t N>
+class RollingWindow
+{
+    static_assert((N > 1) && (N <= std::numeric_limits<uint16_t>::max()),
+    "Hey! RollingWindow capacity must fit the deques' 16-bit positions!!");
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    explicit RollingWindow(const uint32_t & windowSeconds)
+        : m_WindowSeconds(windowSeconds)
+    {
+    }
+
+    RollingWindow(const RollingWindow&) = delete;
+    RollingWindow& operator=(const RollingWindow&) = delete;
+
+    void Add(const time_t & timestamp, const int16_t & temperature_x10, const uint16_t & humidity_x10)
+    {
+        // Should the clock step backwards (i.e. NTP), start afresh rather
+        // than hold on to readings from the "future" for a whole window.
+        if ((m_Count > 0) && (timestamp < m_LatestTimestamp))
+        {
+            Clear();
+        }
+
+        while ((m_Count > 0) && ((m_Count >= N)
+            || (timestamp - static_cast<time_t>(m_Samples[m_Oldest].timestamp)) >= static_cast<time_t>(m_WindowSeconds)))
+        {
+            EvictOldest();
+        }
+
+        const auto position = static_cast<uint16_t>((m_Oldest + m_Count) % N);
+        m_Samples[position] = Sample_t{static_cast<uint32_t>(timestamp), temperature_x10, static_cast<int16_t>(humidity_x10)};
+        ++m_Count;
+
+        m_Temperature.Add(position, temperature_x10, m_Samples, &Sample_t::temperature_x10);
+        m_Humidity.Add(position, static_cast<int16_t>(humidity_x10), m_Samples, &Sample_t::humidity_x10);
+
+        const auto alpha = (m_Count == 1) ? 1.0f
+            : -std::expm1(-static_cast<float>(timestamp - m_LatestTimestamp) / m_WindowSeconds);
+        m_Temperature.UpdateEWMA(temperature_x10 / 10.0f, alpha);
+        m_Humidity.UpdateEWMA(humidity_x10 / 10.0f, alpha);
+
+        m_LatestTimestamp = timestamp;
+    }
+
+    // Carries the readings over to a clock stepped by delta seconds, e.g.
+    // as NTP lands, so that they are neither evicted nor held on to for it.
+    void Rebase(const time_t & delta)
+    {
+        for (size_t i = 0; i < m_Count; i++)
+        {
+            auto & sample = m_Samples[(m_Oldest + i) % N];
+            sample.timestamp = static_cast<uint32_t>(sample.timestamp + delta);
+        }
+        m_LatestTimestamp += delta;
+    }
+
+    void Clear()
+    {
+        m_Oldest = 0;
+        m_Count = 0;
+        m_Temperature.Clear();
+        m_Humidity.Clear();
+    }
+
+    bool     Empty() const { return (m_Count == 0); }
+    uint32_t GetWindowSeconds() const { return m_WindowSeconds; }
+
+    Aggregation::Summary_t GetSummary() const
+    {
+        return Aggregation::Summary_t{m_WindowSeconds, m_LatestTimestamp, static_cast<uint16_t>(m_Count),
+                                      m_Temperature.GetStatistics(m_Samples, &Sample_t::temperature_x10),
+                                      m_Humidity.GetStatistics(m_Samples, &Sample_t::humidity_x10)};
+    }
+
+private:
+    struct Sample_t
+    {
+        uint32_t timestamp;      // Good until 2106, as with the compact codec.
+        int16_t  temperature_x10;
+        int16_t  humidity_x10;   // Never above 1000, so this saves a template.
+    };
+
+    using Samples_t = std::array<Sample_t, N>;
+    using Field_t   = int16_t Sample_t::*;
+
+    class Channel
+    {
+    public:
+        void Add(const uint16_t & position, const int16_t & value, const Samples_t & samples, Field_t field)
+        {
+            while (!m_Minima.Empty() && ((samples[m_Minima.Back()].*field) >= value))
+            {
+                m_Minima.PopBack();
+            }
+            m_Minima.PushBack(position);
+
+            while (!m_Maxima.Empty() && ((samples[m_Maxima.Back()].*field) <= value))
+            {
+                m_Maxima.PopBack();
+            }
+            m_Maxima.PushBack(position);
+
+            m_Moments.Add(value / 10.0);
+        }
+
+        void Remove(const uint16_t & position, const int16_t & value)
+        {
+            if (!m_Minima.Empty() && (m_Minima.Front() == position))
+            {
+                m_Minima.PopFront();
+            }
+
+            if (!m_Maxima.Empty() && (m_Maxima.Front() == position))
+            {
+                m_Maxima.PopFront();
+            }
+
+            m_Moments.Remove(value / 10.0);
+        }
+
+        void UpdateEWMA(const float & value, const float & alpha)
+        {
+            m_EWMA += alpha * (value - m_EWMA);
+        }
+
+        void Clear()
+        {
+            m_Minima.Clear();
+            m_Maxima.Clear();
+            m_Moments.Clear();
+            m_EWMA = 0.0f;
+        }
+
+        Aggregation::ChannelStatistics_t GetStatistics(const Samples_t & samples, Field_t field) const
+        {
+            if (m_Minima.Empty())
+            {
+                return Aggregation::ChannelStatistics_t{};
+            }
+
+            return Aggregation::ChannelStatistics_t{samples[m_Minima.Front()].*field,
+                                                    samples[m_Maxima.Front()].*field,
+                                                    static_cast<float>(m_Moments.GetMean()),
+                                                    static_cast<float>(m_Moments.GetStandardDeviation()),
+                                                    m_EWMA};
+        }
+
+    private:
+        Aggregation::MonotonicDeque<N> m_Minima;
+        Aggregation::MonotonicDeque<N> m_Maxima;
+        Aggregation::Welford           m_Moments;
+        float                          m_EWMA{0.0f};
+    };
+
+    void EvictOldest()
+    {
+        const auto position = static_cast<uint16_t>(m_Oldest);
+        m_Temperature.Remove(position, m_Samples[position].temperature_x10);
+        m_Humidity.Remove(position, m_Samples[position].humidity_x10);
+
+        m_Oldest = (m_Oldest + 1) % N;
+        --m_Count;
+    }
+
+    uint32_t  m_WindowSeconds;
+    time_t    m_LatestTimestamp{0};
+    Samples_t m_Samples{};
+    size_t    m_Oldest{0};
+    size_t    m_Count{0};
+    Channel   m_Temperature;
+    Channel   m_Humidity;
+};
@@ -0,0 +1,451 @@
+#include <algorithm>
+#include "NuerteyReadingsLog.h"
+#include "Utilities.h"
+#include "NuerteyLogger.h"
+#include "MbedCRC.h"
+#include "kvstore_global_api.h"
+
+NuerteyReadingsLog::NuerteyReadingsLog(const uint32_t & baseAddress, const uint32_t & size, const char * tailKey)
+    : m_BlockDevice(baseAddress, size)
+    , m_pTailKey(tailKey)
+    , m_PageCount(0)
+    , m_PagesPerSector(0)
+    , m_IsInitialized(false)
+    , m_HeadSequence(0)
+    , m_Tail{0, 0}
+    , m_CommitTail{0, 0}
+    , m_PersistedTail{0, 0}
+    , m_IsRewound(false)
+    , m_LostReadingsCount(0)
+    , m_StagedPage{}
+    , m_StagedStart(0)
+    , m_StagedCommitted(0)
+    , m_PageBuffer{}
+    , m_CommitPageBuffer{}
+{
+}
+
+NuerteyReadingsLog::~NuerteyReadingsLog()
+{
+    if (m_IsInitialized)
+    {
+        [[maybe_unused]] auto synced = Sync();
+        m_BlockDevice.deinit();
+    }
+}
+
+bool NuerteyReadingsLog::Init()
+{
+    int rc = m_BlockDevice.init();
+    if (rc != 0)
+    {
+        LOG_ERROR("Error! FlashIAPBlockDevice.init() returned: [%d]\r\n", rc);
+        return false;
+    }
+
+    // The region must consist of at least two uniformly sized sectors so
+    // that erasing one for reuse does not take the whole log down with it.
+    const auto sectorSize = m_BlockDevice.get_erase_size(0);
+    const auto programSize = m_BlockDevice.get_program_size();
+
+    if ((sectorSize == 0) || (sectorSize % LOG_PAGE_BYTES)
+        || (LOG_PAGE_BYTES % programSize)
+        || (m_BlockDevice.get_erase_size(m_BlockDevice.size() - 1) != sectorSize)
+        || (m_BlockDevice.size() < (2 * sectorSize)))
+    {
+        LOG_ERROR("Error! Flash region of [%llu] bytes in sectors of [%llu] bytes is unsuitable for the readings log.\r\n",
+                  m_BlockDevice.size(), sectorSize);
+        m_BlockDevice.deinit();
+        return false;
+    }
+
+    m_PagesPerSector = sectorSize / LOG_PAGE_BYTES;
+    m_PageCount = (m_BlockDevice.size() / sectorSize) * m_PagesPerSector;
+
+    // Recover the head from the newest valid page. Interrupted pages fail
+    // their CRC and are skipped over like erased ones.
+    bool isAnyPageValid = false;
+    uint32_t oldestSequence = 0;
+    uint32_t newestSequence = 0;
+
+    for (uint32_t slot = 0; slot < m_PageCount; slot++)
+    {
+        if ((m_BlockDevice.read(&m_PageBuffer, static_cast<uint64_t>(slot) * LOG_PAGE_BYTES, LOG_PAGE_BYTES) == 0)
+            && IsPageValid(m_PageBuffer) && ((m_PageBuffer.header.sequence % m_PageCount) == slot))
+        {
+            const auto sequence = m_PageBuffer.header.sequence;
+            oldestSequence = isAnyPageValid ? std::min(oldestSequence, sequence) : sequence;
+            newestSequence = isAnyPageValid ? std::max(newestSequence, sequence) : sequence;
+            isAnyPageValid = true;
+        }
+    }
+
+    size_t length = 0;
+    Tail_t tail{0, 0};
+    bool isTailPersisted = (kv_get(m_pTailKey, &tail, sizeof(tail), &length) == 0) && (length == sizeof(tail));
+
+    m_HeadSequence = isAnyPageValid ? (newestSequence + 1) : (isTailPersisted ? tail.sequence : 0);
+
+    if (!isTailPersisted)
+    {
+        tail = Tail_t{isAnyPageValid ? oldestSequence : m_HeadSequence, 0};
+    }
+    else if (isAnyPageValid && (tail.sequence < oldestSequence))
+    {
+        // Overwritten before it could be forwarded.
+        LOG_WARNING("Warning! Readings log tail [%lu] predates its oldest page [%lu].\r\n",
+                    static_cast<unsigned long>(tail.sequence), static_cast<unsigned long>(oldestSequence));
+        tail = Tail_t{oldestSequence, 0};
+    }
+    else if (!isAnyPageValid || (tail.sequence > m_HeadSequence))
+    {
+        // Including pages of a former record layout, which fail validation.
+        tail = Tail_t{m_HeadSequence, 0};
+    }
+
+    m_Tail = tail;
+    m_CommitTail = tail;
+    m_PersistedTail = tail;
+
+    // Should power have been lost midway through programming, the slot
+    // at the head is dirty and cannot be programmed until it is erased.
+    while (((m_HeadSequence % m_PagesPerSector) != 0) && !IsPageErased(m_HeadSequence))
+    {
+        ++m_HeadSequence;
+    }
+
+    m_StagedPage.header.count = 0;
+    m_StagedStart = 0;
+    m_StagedCommitted = 0;
+    m_IsInitialized = true;
+
+    LOG_INFO("Readings log of [%lu] pages initialized; [%lu] pages pending.\r\n",
+             static_cast<unsigned long>(m_PageCount), static_cast<unsigned long>(GetPendingPageCount()));
+
+    PersistTail();
+    return true;
+}
+
+bool NuerteyReadingsLog::Append(const CompactReading_t & reading)
+{
+    if (!m_IsInitialized)
+    {
+        return false;
+    }
+
+    if (reading.status != SensorStatus_t::SUCCESS)
+    {
+        return true;
+    }
+
+    // A full page that failed to program is retried rather than overrun.
+    if ((m_StagedPage.header.count >= RECORDS_PER_PAGE) && !ProgramStagedPage())
+    {
+        return false;
+    }
+
+    m_StagedPage.records[m_StagedPage.header.count++] = Record_t{static_cast<uint32_t>(reading.timestamp_ms / 1000),
+                                                                 static_cast<uint16_t>(reading.timestamp_ms % 1000),
+                                                                 reading.temperature_x10,
+                                                                 reading.humidity_x10,
+                                                                 reading.channels,
+                                                                 0};
+
+    if (m_StagedPage.header.count >= RECORDS_PER_PAGE)
+    {
+        // Room made by acknowledged readings spares programming a page
+        // of but a few.
+        CompactStagedPage();
+        if (m_StagedPage.header.count >= RECORDS_PER_PAGE)
+        {
+            return ProgramStagedPage();
+        }
+    }
+
+    return true;
+}
+
+bool NuerteyReadingsLog::Sync()
+{
+    return (m_IsInitialized && ProgramStagedPage());
+}
+
+size_t NuerteyReadingsLog::Drain(ReadingSink_t sink, const size_t & maximumReadings)
+{
+    size_t drained = 0;
+
+    if (!m_IsInitialized || !sink)
+    {
+        return drained;
+    }
+
+    m_IsRewound = false;
+
+    // The programmed pages are older than whatever is still staged.
+    while ((drained < maximumReadings) && (m_Tail.sequence < m_HeadSequence))
+    {
+        if (!ReadPage(m_Tail.sequence, m_PageBuffer))
+        {
+            // A page interrupted by power loss, or skipped over; never written.
+            m_Tail = Tail_t{m_Tail.sequence + 1, 0};
+            continue;
+        }
+
+        while ((drained < maximumReadings) && (m_Tail.index < m_PageBuffer.header.count))
+        {
+            if (!sink(ToCompactReading(m_PageBuffer.records[m_Tail.index])) || m_IsRewound)
+            {
+                return drained;
+            }
+            ++m_Tail.index;
+            ++drained;
+        }
+
+        if (m_Tail.index >= m_PageBuffer.header.count)
+        {
+            m_Tail = Tail_t{m_Tail.sequence + 1, 0};
+        }
+    }
+
+    while ((drained < maximumReadings) && (m_StagedStart < m_StagedPage.header.count))
+    {
+        if (!sink(ToCompactReading(m_StagedPage.records[m_StagedStart])) || m_IsRewound)
+        {
+            break;
+        }
+        ++m_StagedStart;
+        ++drained;
+    }
+
+    return drained;
+}
+
+void NuerteyReadingsLog::Commit(size_t count)
+{
+    if (!m_IsInitialized)
+    {
+        return;
+    }
+
+    // Readings were drained in order, the programmed pages before whatever
+    // is staged, and are hence committed likewise.
+    while ((count > 0) && (m_CommitTail.sequence < m_Tail.sequence))
+    {
+        if (!ReadPage(m_CommitTail.sequence, m_CommitPageBuffer))
+        {
+            // Skipped over by Drain() too.
+            m_CommitTail = Tail_t{m_CommitTail.sequence + 1, 0};
+            continue;
+        }
+
+        const size_t pageCount = m_CommitPageBuffer.header.count;
+        const auto committed = std::min(count, (pageCount > m_CommitTail.index) ? (pageCount - m_CommitTail.index) : 0);
+        m_CommitTail.index += committed;
+        count -= committed;
+
+        if (m_CommitTail.index >= pageCount)
+        {
+            m_CommitTail = Tail_t{m_CommitTail.sequence + 1, 0};
+        }
+    }
+
+    if ((count > 0) && (m_CommitTail.sequence == m_Tail.sequence) && (m_CommitTail.index < m_Tail.index))
+    {
+        const auto committed = std::min<size_t>(count, m_Tail.index - m_CommitTail.index);
+        m_CommitTail.index += committed;
+        count -= committed;
+    }
+
+    if ((count > 0) && (m_CommitTail.sequence >= m_HeadSequence))
+    {
+        m_StagedCommitted = std::min(m_StagedCommitted + count, m_StagedStart);
+    }
+
+    if (m_StagedCommitted >= m_StagedPage.header.count)
+    {
+        m_StagedPage.header.count = 0;
+        m_StagedStart = 0;
+        m_StagedCommitted = 0;
+    }
+
+    PersistTail();
+}
+
+void NuerteyReadingsLog::Rewind()
+{
+    m_Tail = m_CommitTail;
+    m_StagedStart = m_StagedCommitted;
+    m_IsRewound = true;
+}
+
+bool NuerteyReadingsLog::IsEmpty() const
+{
+    return ((m_Tail.sequence >= m_HeadSequence) && (m_StagedStart >= m_StagedPage.header.count));
+}
+
+uint64_t NuerteyReadingsLog::PageAddress(const uint32_t & sequence) const
+{
+    return (static_cast<uint64_t>(sequence % m_PageCount) * LOG_PAGE_BYTES);
+}
+
+bool NuerteyReadingsLog::ReadPage(const uint32_t & sequence, Page_t & page)
+{
+    if (m_BlockDevice.read(&page, PageAddress(sequence), LOG_PAGE_BYTES) != 0)
+    {
+        return false;
+    }
+
+    return ((page.header.sequence == sequence) && IsPageValid(page));
+}
+
+bool NuerteyReadingsLog::IsPageValid(const Page_t & page) const
+{
+    return ((page.header.magic == LOG_PAGE_MAGIC)
+         && (page.header.count <= RECORDS_PER_PAGE)
+         && (page.header.crc == ComputeCRC(page)));
+}
+
+bool NuerteyReadingsLog::IsPageErased(const uint32_t & sequence)
+{
+    if (m_BlockDevice.read(&m_PageBuffer, PageAddress(sequence), LOG_PAGE_BYTES) != 0)
+    {
+        return false;
+    }
+
+    const auto erasedValue = static_cast<uint8_t>(m_BlockDevice.get_erase_value());
+    const auto * pBytes = reinterpret_cast<const uint8_t *>(&m_PageBuffer);
+
+    return std::all_of(pBytes, pBytes + LOG_PAGE_BYTES, [erasedValue](const uint8_t & byte){ return (byte == erasedValue); });
+}
+
+bool NuerteyReadingsLog::ProgramStagedPage()
+{
+    CompactStagedPage();
+
+    if (m_StagedPage.header.count == 0)
+    {
+        return true;
+    }
+
+    // Drained, though not committed, straight out of RAM; draining then
+    // resumes within the page about to be programmed.
+    const bool isTailStaged = (m_Tail.sequence == m_HeadSequence);
+
+    if ((m_HeadSequence % m_PagesPerSector) == 0)
+    {
+        // About to erase the sector holding the oldest pages. Any that were
+        // not forwarded yet are lost.
+        if (m_HeadSequence >= m_PageCount)
+        {
+            const auto survivingSequence = m_HeadSequence - m_PageCount + m_PagesPerSector;
+
+            while (m_CommitTail.sequence < survivingSequence)
+            {
+                if (ReadPage(m_CommitTail.sequence, m_PageBuffer))
+                {
+                    m_LostReadingsCount += (m_PageBuffer.header.count - m_CommitTail.index);
+                }
+                m_CommitTail = Tail_t{m_CommitTail.sequence + 1, 0};
+            }
+
+            if (m_Tail.sequence < m_CommitTail.sequence)
+            {
+                m_Tail = m_CommitTail;
+            }
+            PersistTail();
+        }
+
+        int rc = m_BlockDevice.erase(PageAddress(m_HeadSequence), m_PagesPerSector * LOG_PAGE_BYTES);
+        if (rc != 0)
+        {
+            LOG_ERROR("Error! FlashIAPBlockDevice.erase() returned: [%d]\r\n", rc);
+            return false;
+        }
+    }
+
+    m_StagedPage.header.magic = LOG_PAGE_MAGIC;
+    m_StagedPage.header.sequence = m_HeadSequence;
+    m_StagedPage.header.reserved = 0;
+    m_StagedPage.header.crc = ComputeCRC(m_StagedPage);
+
+    // A whole page in one go; a partial program fails its CRC on reading.
+    int rc = m_BlockDevice.program(&m_StagedPage, PageAddress(m_HeadSequence), LOG_PAGE_BYTES);
+
+    // Either way, that slot is spent.
+    ++m_HeadSequence;
+
+    if (rc != 0)
+    {
+        LOG_ERROR("Error! FlashIAPBlockDevice.program() returned: [%d]\r\n", rc);
+        return false;
+    }
+
+    if (isTailStaged)
+    {
+        m_Tail = Tail_t{m_StagedPage.header.sequence, static_cast<uint16_t>(m_StagedStart)};
+    }
+
+    m_StagedPage.header.count = 0;
+    m_StagedStart = 0;
+    return true;
+}
+
+void NuerteyReadingsLog::CompactStagedPage()
+{
+    // Whatever was acknowledged straight out of RAM need not hit the flash.
+    // Whatever is merely in flight must, lest it have to be replayed.
+    if (m_StagedCommitted == 0)
+    {
+        return;
+    }
+
+    std::copy(m_StagedPage.records.begin() + m_StagedCommitted,
+              m_StagedPage.records.begin() + m_StagedPage.header.count,
+              m_StagedPage.records.begin());
+    m_StagedPage.header.count -= m_StagedCommitted;
+    m_StagedStart -= m_StagedCommitted;
+    m_StagedCommitted = 0;
+}
+
+void NuerteyReadingsLog::PersistTail()
+{
+    // Only across page boundaries so as to spare the KVStore the wear; at
+    // worst the page in progress is replayed once more after a reset.
+    if (m_CommitTail.sequence == m_PersistedTail.sequence)
+    {
+        return;
+    }
+
+    int rc = kv_set(m_pTailKey, &m_CommitTail, sizeof(m_CommitTail), 0);
+    if (rc != 0)
+    {
+        LOG_ERROR("Error! kv_set(\"%s\") returned: [%d]\r\n", m_pTailKey, rc);
+        return;
+    }
+
+    m_PersistedTail = m_CommitTail;
+}
+
+uint32_t NuerteyReadingsLog::ComputeCRC(const Page_t & page) const
+{
+    PageHeader_t header = page.header;
+    header.crc = 0;
+
+    uint32_t crc = 0;
+    MbedCRC<POLY_32BIT_ANSI, 32> ct;
+    ct.compute_partial_start(&crc);
+    ct.compute_partial(&header, sizeof(header), &crc);
+    ct.compute_partial(page.records.data(), std::min<size_t>(page.header.count, RECORDS_PER_PAGE) * sizeof(Record_t), &crc);
+    ct.compute_partial_stop(&crc);
+
+    return crc;
+}
+
+CompactReading_t NuerteyReadingsLog::ToCompactReading(const Record_t & record)
+{
+    return CompactReading_t{(static_cast<int64_t>(record.seconds) * 1000) + record.milliseconds,
+                            record.temperature_x10,
+                            record.humidity_x10,
+                            SensorStatus_t::SUCCESS,
+                            record.channels};
+}
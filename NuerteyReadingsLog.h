@@ -0,0 +1,156 @@
+/***********************************************************************
+* @file      NuerteyReadingsLog.h
+*
+*    Append-only, flash-backed store-and-forward log of compact sensor
+*    readings, for riding out network outages longer than the RAM ring.
+*
+* @brief   Readings are staged in RAM and programmed a whole page at a
+*          time, each page carrying a sequence number and a CRC so that a
+*          page interrupted by a power loss is simply never seen. The log
+*          wraps around its region, erasing each sector just before it is
+*          reused, so that wear is spread evenly over every sector.
+*
+*          Draining merely hands readings out; they are only let go of
+*          once Commit()'ed, i.e. acknowledged by the broker, and else 
+*          Rewind() hands them out afresh. How far the log has been 
+*          committed (the tail) is persisted in KVStore, whereas the head
+*          is recovered on Init() by scanning the page headers.
+*
+* @note    Once the log is full, the oldest sector's worth of readings is
+*          sacrificed for the newest, and those losses are counted.
+*
+*          Delivery is at least once; whatever was drained but not yet
+*          committed is replayed after a Rewind(), and should power be lost
+*          midway through committing a page, that page is replayed in full.
+*
+* @warning On the NUCLEO-F767ZI in its default single bank mode, erasing
+*          a 256 KB sector stalls the CPU for a second or two as the code
+*          executes from the same bank. That happens once per sector's
+*          worth of readings logged, i.e. once a day or so whilst offline.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "mbed.h"
+#include "FlashIAPBlockDevice.h"
+#include "NuerteyDHT11Device.h"
+
+class NuerteyReadingsLog
+{
+public:
+    static constexpr uint32_t LOG_PAGE_MAGIC    = 0x3254484E; // "NHT2", i.e. millisecond records.
+    static constexpr size_t   LOG_PAGE_BYTES    = 512;
+
+    // Returns false to stop draining, i.e. the reading could not be sent.
+    // It may Commit() or Rewind() meanwhile; after a Rewind(), draining
+    // stops regardless.
+    using ReadingSink_t = mbed::Callback<bool(const CompactReading_t &)>;
+
+    NuerteyReadingsLog(const uint32_t & baseAddress, const uint32_t & size, const char * tailKey);
+
+    NuerteyReadingsLog(const NuerteyReadingsLog&) = delete;
+    NuerteyReadingsLog& operator=(const NuerteyReadingsLog&) = delete;
+
+    virtual ~NuerteyReadingsLog();
+
+    [[nodiscard]] bool Init();
+
+    // Only successful readings are logged.
+    [[nodiscard]] bool Append(const CompactReading_t & reading);
+
+    // Programs whatever is staged now rather than once the page is full.
+    [[nodiscard]] bool Sync();
+
+    // Feeds up to maximumReadings of the oldest readings not yet drained,
+    // in order, to sink.
+    size_t Drain(ReadingSink_t sink, const size_t & maximumReadings);
+
+    // Lets go of the oldest count readings drained, once acknowledged.
+    void Commit(size_t count);
+
+    // Whatever was drained but not committed is to be drained afresh.
+    void Rewind();
+
+    bool     IsAvailable() const { return m_IsInitialized; }
+
+    // Whether everything has been drained, not necessarily committed.
+    bool     IsEmpty() const;
+    uint32_t GetPendingPageCount() const { return (m_HeadSequence - m_CommitTail.sequence); }
+    uint32_t GetLostReadingsCount() const { return m_LostReadingsCount; }
+
+private:
+    struct PageHeader_t
+    {
+        uint32_t magic;
+        uint32_t sequence;
+        uint16_t count;
+        uint16_t reserved;
+        uint32_t crc;       // Over the header, with crc itself 0, and the records.
+    };
+
+    struct Record_t
+    {
+        uint32_t seconds;      // Since the UNIX epoch; good until 2106.
+        uint16_t milliseconds;
+        int16_t  temperature_x10;
+        uint16_t humidity_x10;
+        uint8_t  channels;     // ReadingChannels_t.
+        uint8_t  reserved;
+    };
+
+    static constexpr size_t RECORDS_PER_PAGE = (LOG_PAGE_BYTES - sizeof(PageHeader_t)) / sizeof(Record_t);
+
+    struct Page_t
+    {
+        PageHeader_t                           header;
+        std::array<Record_t, RECORDS_PER_PAGE> records;
+        std::array<uint8_t, LOG_PAGE_BYTES - sizeof(PageHeader_t) - (RECORDS_PER_PAGE * sizeof(Record_t))> padding;
+    };
+
+    static_assert(sizeof(Page_t) == LOG_PAGE_BYTES, "Hey! Log page layout must fill LOG_PAGE_BYTES exactly!!");
+
+    // Record index within the page of sequence; where draining resumes from,
+    // or the oldest reading not yet committed.
+    struct Tail_t
+    {
+        uint32_t sequence;
+        uint16_t index;
+    };
+
+    uint64_t PageAddress(const uint32_t & sequence) const;
+    bool     ReadPage(const uint32_t & sequence, Page_t & page);
+    bool     IsPageValid(const Page_t & page) const;
+    bool     IsPageErased(const uint32_t & sequence);
+    bool     ProgramStagedPage();
+    void     CompactStagedPage();
+    void     PersistTail();
+    uint32_t ComputeCRC(const Page_t & page) const;
+
+    static CompactReading_t ToCompactReading(const Record_t & record);
+
+    FlashIAPBlockDevice          m_BlockDevice;
+    const char *                 m_pTailKey;
+    uint32_t                     m_PageCount;
+    uint32_t                     m_PagesPerSector;
+    bool                         m_IsInitialized;
+
+    uint32_t                     m_HeadSequence;   // Of the next page to be programmed.
+    Tail_t                       m_Tail;           // Drained up to.
+    Tail_t                       m_CommitTail;     // Committed up to; never past m_Tail.
+    Tail_t                       m_PersistedTail;
+    bool                         m_IsRewound;
+    uint32_t                     m_LostReadingsCount;
+
+    Page_t                       m_StagedPage;
+    size_t                       m_StagedStart;    // Staged records already drained.
+    size_t                       m_StagedCommitted; // Of those, the ones committed.
+    Page_t                       m_PageBuffer;
+    Page_t                       m_CommitPageBuffer; // Commit() may run from within Drain().
+};
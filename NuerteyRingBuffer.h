@@ -0,0 +1,121 @@
+/***********************************************************************
+* @file      NuerteyRingBuffer.h
+*
+*    Fixed-capacity, statically allocated, lock-free ring buffer for 
+*    exactly one producer and exactly one consumer.
+* 
+* @brief   Decouple a producer running at its own cadence (i.e. the  
+*          sensor acquisition) from a consumer of unpredictable latency 
+*          (i.e. the network) without either of them ever blocking on, or
+*          allocating for, the other.
+* 
+* @note    The producer only ever writes m_Head and the consumer only ever
+*          writes m_Tail, so a pair of acquire/release atomics suffices;
+*          no mutex, no critical section, no heap. Either side may run in
+*          an ISR. One slot is NOT sacrificed to tell full from empty as 
+*          the indices are free-running and only reduced modulo the 
+*          (power of two) capacity on access.
+*
+* @warning   Strictly single-producer/single-consumer. Two threads pushing
+*            (or popping) concurrently will corrupt the buffer.
+*
+* @author    Nuertey Odzeyem
+* 
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+template <typename T, size_t N>
+class SPSCRingBuffer
+{
+    static_assert((N > 0) && ((N & (N - 1)) == 0), 
+    "Hey! SPSCRingBuffer capacity must be a power of two!!");
+
+    static_assert(std::is_trivially_copyable<T>::value,
+    "Hey! SPSCRingBuffer elements are copied around by value and must be trivially copyable!!");
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    SPSCRingBuffer() = default;
+
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    // Producer side. A full buffer rejects the newest element (and counts
+    // it) rather than overwriting the oldest, as the consumer may be 
+    // reading that very slot.
+    [[nodiscard]] bool Push(const T & element)
+    {
+        const auto head = m_Head.load(std::memory_order_relaxed);
+        const auto tail = m_Tail.load(std::memory_order_acquire);
+
+        if ((head - tail) >= N)
+        {
+            m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_Elements[head & (N - 1)] = element;
+        m_Head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer side.
+    [[nodiscard]] bool Pop(T & element)
+    {
+        const auto tail = m_Tail.load(std::memory_order_relaxed);
+        const auto head = m_Head.load(std::memory_order_acquire);
+
+        if (head == tail)
+        {
+            return false;
+        }
+
+        element = m_Elements[tail & (N - 1)];
+        m_Tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer side. Inspect the oldest element without consuming it.
+    [[nodiscard]] bool Peek(T & element) const
+    {
+        const auto tail = m_Tail.load(std::memory_order_relaxed);
+        const auto head = m_Head.load(std::memory_order_acquire);
+
+        if (head == tail)
+        {
+            return false;
+        }
+
+        element = m_Elements[tail & (N - 1)];
+
+        return true;
+    }
+
+    // Approximate when called from anywhere but the consumer side.
+    size_t Size() const
+    {
+        return (m_Head.load(std::memory_order_acquire) - m_Tail.load(std::memory_order_acquire));
+    }
+
+    bool     Empty() const { return (Size() == 0); }
+    bool     Full() const { return (Size() >= N); }
+    uint32_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+
+private:
+    std::array<T, N>      m_Elements{};
+    std::atomic<size_t>   m_Head{0};
+    std::atomic<size_t>   m_Tail{0};
+    std::atomic<uint32_t> m_DroppedCount{0};
+};
@@ -0,0 +1,8 @@
+#include "NuerteySensorArray.h"
+
+// The scheduler is header-only and not (yet) part of the application, so
+// instantiate the very configuration that its documentation advertises.
+// Every build thereby compiles it, static_assert's and all.
+template class NuerteySensorArray<NuerteyDHT11Device<DHT11_t, PE_13>,
+                                  NuerteyDHT11Device<DHT22_t, PE_9>,
+                                  NuerteyDHT11Device<DHT22_t, PF_14>>;
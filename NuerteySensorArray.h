@@ -0,0 +1,248 @@
+/***********************************************************************
+* @file      NuerteySensorArray.h
+*
+*    Scheduler for several DHT11/DHT22 sensors wired to the one board.
+* 
+*    The sensors are described entirely at compile-time as a variadic 
+*    list of NuerteyDHT11Device<> instantiations, so that a mix of 
+*    DHT11 and DHT22 probes on arbitrary (valid) pins costs nothing 
+*    more than the sum of the drivers themselves.
+*
+* @brief   Interleave the reads of N sensors on one EventQueue such that
+*          one sensor's 18ms wake-up signal overlaps with another's frame
+*          capture, whilst still honouring each sensor's own minimum
+*          sampling period.
+* 
+* @note    Each sensor is sampled on its own call_every() event, phase
+*          shifted from its neighbours by (period / N). As the start signal
+*          of a read is merely a timed event on the EventQueue (courtesy of
+*          ReadDataAsync()), nothing prevents N start signals from being in
+*          progress at once; only the ~10ms frame capture windows have to be
+*          kept apart, which the phase shift ensures. Aggregate throughput is
+*          therefore N samples per period rather than the 1 / (N * ~25ms) 
+*          dead time of sequential blocking reads. The period is clamped to
+*          just above the slowest sensor type's MINIMUM_READ_INTERVAL, i.e.
+*          1000ms for DHT11s and 2000ms for DHT22s, plus SAMPLING_PERIOD_MARGIN,
+*          hence about 8 Hz in all for 8 DHT11s, 4 Hz for 8 DHT22s or a mix.
+*
+*          The sensors' own retries are disabled: one a second later would
+*          land on a neighbour's capture window, and the next periodic read
+*          serves as the retry anyway.
+* 
+* @code
+*   NuerteySensorArray<NuerteyDHT11Device<DHT11_t, PE_13>,
+*                      NuerteyDHT11Device<DHT22_t, PE_9>,
+*                      NuerteyDHT11Device<DHT22_t, PF_14>> theSensors(g_pMasterEventQueue, 3000ms);
+*
+*   theSensors.Start([](size_t index, std::error_code result, SensorReading_t reading) {...});
+* @endcode
+*
+* @warning   On STM32 targets, pins of the same number on different ports
+*            (e.g. PA_13 and PE_13) share one EXTI line and hence can not
+*            both host an edge-capturing sensor. As the array reads every
+*            sensor by ReadDataAsync(), which captures edges whatever the
+*            sensor's AcquisitionMode_t, this holds for polling ones too,
+*            and is enforced at compile-time below.
+*
+* @author    Nuertey Odzeyem
+* 
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <tuple>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <system_error>
+#include "mbed.h"
+#include "Utilities.h"
+#include "NuerteyDHT11Device.h"
+
+namespace SensorArray
+{
+    template <PinName... thePinNames>
+    constexpr bool AreInterruptLinesDistinct()
+    {
+        constexpr std::array<int, sizeof...(thePinNames)> pins{static_cast<int>(thePinNames)...};
+
+        for (size_t i = 0; i < pins.size(); i++)
+        {
+            for (size_t j = i + 1; j < pins.size(); j++)
+            {
+#if defined(TARGET_STM)
+                // STM32 PinName encoding is (port << 4) | pin, and the EXTI
+                // line is selected by the pin number alone.
+                if ((pins[i] & 0x0F) == (pins[j] & 0x0F))
+#else
+                if (pins[i] == pins[j])
+#endif
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+} // namespace
+
+// Every sensor's reading is delivered with the index of that sensor's 
+// type within the template argument list.
+using SensorArrayCallback_t = mbed::Callback<void(size_t, std::error_code, SensorReading_t)>;
+
+template <typename... Devices>
+class NuerteySensorArray
+{
+    static_assert(sizeof...(Devices) > 0, 
+    "Hey! NuerteySensorArray needs at least one sensor to schedule!!");
+
+    static_assert(SensorArray::AreInterruptLinesDistinct<Devices::DATA_PIN_NAME...>(),
+    "Hey! Each sensor of a NuerteySensorArray needs its own pin and interrupt line!!");
+
+public:
+    static constexpr size_t SENSOR_COUNT = sizeof...(Devices);
+
+    // The start signal (20ms) overlaps freely, the frame capture window 
+    // (~10ms after releasing the bus) must not. Add a little margin.
+    static constexpr MilliSecs_t MINIMUM_INTERLEAVE_PERIOD = 12ms;
+
+    // Were the period exactly the sensors' MINIMUM_READ_INTERVAL, a read
+    // dispatched the least bit early would be throttled, and served the
+    // cached reading as though it were fresh. Keep clear of that.
+    static constexpr MilliSecs_t SAMPLING_PERIOD_MARGIN = 50ms;
+
+    NuerteySensorArray(EventQueue * pEventQueue, const MilliSecs_t & samplingPeriod);
+
+    NuerteySensorArray(const NuerteySensorArray&) = delete;
+    NuerteySensorArray& operator=(const NuerteySensorArray&) = delete;
+
+    virtual ~NuerteySensorArray();
+
+    void Start(SensorArrayCallback_t onReading);
+
+    // Also abandons the reads in progress, whose completions would else
+    // still be delivered. As with CancelAsyncRead(), only to be called from
+    // the context of the EventQueue, or whilst it is not dispatching.
+    void Stop();
+
+    template <size_t I>
+    auto & GetSensor() { return std::get<I>(m_TheSensors); }
+
+    MilliSecs_t GetSamplingPeriod() const { return m_TheSamplingPeriod; }
+    MilliSecs_t GetInterleavePeriod() const { return m_TheInterleavePeriod; }
+
+    // Shared by all of the sensors, so that their readings line up.
+    void SetTimestampSource(TimestampSource_t source)
+    {
+        std::apply([&source](auto &... sensors) { (sensors.SetTimestampSource(source), ...); }, m_TheSensors);
+    }
+
+private:
+    // The slowest sensor type in the list dictates the common period.
+    static constexpr MilliSecs_t MINIMUM_SAMPLING_PERIOD = std::max({
+        std::chrono::duration_cast<MilliSecs_t>(Devices::MINIMUM_READ_INTERVAL)...}) + SAMPLING_PERIOD_MARGIN;
+
+    template <size_t... Is>
+    void StartAll(std::index_sequence<Is...>);
+
+    template <size_t I>
+    void StartSensor();
+
+    template <size_t I>
+    void SampleSensor();
+
+    std::tuple<Devices...>              m_TheSensors;
+    EventQueue *                        m_pTheEventQueue;
+    MilliSecs_t                         m_TheSamplingPeriod;
+    MilliSecs_t                         m_TheInterleavePeriod;
+    SensorArrayCallback_t               m_TheReadingCallback;
+    std::array<int, SENSOR_COUNT>       m_TheEventIds;
+};
+
+template <typename... Devices>
+NuerteySensorArray<Devices...>::NuerteySensorArray(EventQueue * pEventQueue, const MilliSecs_t & samplingPeriod)
+    : m_TheSensors()
+    , m_pTheEventQueue(pEventQueue)
+    , m_TheSamplingPeriod(std::max(samplingPeriod, MINIMUM_SAMPLING_PERIOD))
+    , m_TheInterleavePeriod(std::max(m_TheSamplingPeriod / static_cast<int>(SENSOR_COUNT), MINIMUM_INTERLEAVE_PERIOD))
+    , m_TheReadingCallback(nullptr)
+    , m_TheEventIds{}
+{
+    MBED_ASSERT(m_pTheEventQueue);
+
+    std::apply([](auto &... sensors) { (sensors.SetMaximumRetries(0), ...); }, m_TheSensors);
+}
+
+template <typename... Devices>
+NuerteySensorArray<Devices...>::~NuerteySensorArray()
+{
+    Stop();
+}
+
+template <typename... Devices>
+void NuerteySensorArray<Devices...>::Start(SensorArrayCallback_t onReading)
+{
+    Stop();
+
+    m_TheReadingCallback = onReading;
+    StartAll(std::index_sequence_for<Devices...>{});
+}
+
+template <typename... Devices>
+void NuerteySensorArray<Devices...>::Stop()
+{
+    for (auto & id : m_TheEventIds)
+    {
+        if (id != 0)
+        {
+            m_pTheEventQueue->cancel(id);
+            id = 0;
+        }
+    }
+
+    std::apply([](auto &... sensors) { (sensors.CancelAsyncRead(), ...); }, m_TheSensors);
+}
+
+template <typename... Devices>
+template <size_t... Is>
+void NuerteySensorArray<Devices...>::StartAll(std::index_sequence<Is...>)
+{
+    // Phase shift each sensor from its predecessor. Should the interleave
+    // period have been clamped up, the tail sensors simply start later.
+    ((m_TheEventIds[Is] = m_pTheEventQueue->call_in(m_TheInterleavePeriod * static_cast<int>(Is), 
+                                                    this, 
+                                                    &NuerteySensorArray::template StartSensor<Is>)), ...);
+}
+
+template <typename... Devices>
+template <size_t I>
+void NuerteySensorArray<Devices...>::StartSensor()
+{
+    m_TheEventIds[I] = m_pTheEventQueue->call_every(m_TheSamplingPeriod, 
+                                                    this, 
+                                                    &NuerteySensorArray::template SampleSensor<I>);
+    SampleSensor<I>();
+}
+
+template <typename... Devices>
+template <size_t I>
+void NuerteySensorArray<Devices...>::SampleSensor()
+{
+    auto result = std::get<I>(m_TheSensors).ReadDataAsync(
+        [this](std::error_code errorCode, SensorReading_t reading)
+        {
+            if (m_TheReadingCallback)
+            {
+                m_TheReadingCallback(I, errorCode, reading);
+            }
+        }, 
+        m_pTheEventQueue);
+
+    if (result && m_TheReadingCallback)
+    {
+        // The previous read of this very sensor has not even completed.
+        m_TheReadingCallback(I, result, std::get<I>(m_TheSensors).GetLastReading());
+    }
+}
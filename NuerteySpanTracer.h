@@ -0,0 +1,191 @@
+/***********************************************************************
+* @file      NuerteySpanTracer.h
+*
+*    Cycle-accurate timing of the application's hot paths, by means of
+*    the Cortex-M7 DWT cycle counter.
+*
+* @brief   CycleCounterClock_t is a std::chrono clock ticking at the core
+*          clock, i.e. 4.63ns apart. ScopedSpan times whatever scope it is
+*          declared in into one of a fixed set of named stages, whose
+*          count, minimum, maximum and mean are then reported on demand.
+*
+* @note    Recording a span costs two register reads and a short critical
+*          section; no allocations, no strings, no locks.
+*
+*          ScopedSpan measures on the raw 32-bit counter and so is exact
+*          for anything shorter than its ~19.9s wrap period. Spans that
+*          may outlast it, i.e. NTP rounds with their DNS lookups and
+*          timeouts, are timed by ScopedKernelSpan off Kernel::Clock
+*          instead, to the millisecond. Absolute time_points are extended
+*          to 64 bits on the assumption that now() is called at least
+*          once per wrap period, which a blocking span cannot promise.
+*
+* @warning   The DWT is shared with debuggers; attaching one may reset or
+*            stop the counter.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include "mbed.h"
+
+struct CycleCounterClock_t
+{
+    using rep        = std::int64_t;
+    using period     = std::ratio<1, 216'000'000>; // Processor speed, 1 tick == 4.62962963ns
+    using duration   = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<CycleCounterClock_t>;
+    static constexpr bool is_steady = true;
+
+    // Must precede any use; harmless to repeat.
+    static void Enable() noexcept
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CORTEX_M) && (__CORTEX_M == 7U)
+        DWT->LAR = 0xC5ACCE55; // Cortex-M7 ignores DWT writes until unlocked.
+#endif
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    static uint32_t Cycles() noexcept { return DWT->CYCCNT; }
+
+    static time_point now() noexcept
+    {
+        core_util_critical_section_enter();
+        const auto cycles = Cycles();
+        if (cycles < s_LastCycles)
+        {
+            ++s_Wraps;
+        }
+        s_LastCycles = cycles;
+        const auto wraps = s_Wraps;
+        core_util_critical_section_exit();
+
+        return time_point(duration((static_cast<rep>(wraps) << 32) | cycles));
+    }
+
+    static uint32_t ToMicroseconds(const uint64_t & cycles) noexcept
+    {
+        return static_cast<uint32_t>(cycles / (period::den / 1'000'000));
+    }
+
+private:
+    static inline uint32_t s_LastCycles = 0;
+    static inline uint32_t s_Wraps = 0;
+};
+
+enum class Span_t : uint8_t
+{
+    SENSOR_READ,  // From ReadDataAsync() to its callback.
+    FORMATTING,
+    LCD_UPDATE,
+    MQTT_PUBLISH,
+    MQTT_YIELD,
+    NTP_SYNC,
+    SPAN_COUNT
+};
+
+class SpanTracer
+{
+public:
+    static constexpr size_t SPAN_COUNT = static_cast<size_t>(Span_t::SPAN_COUNT);
+
+    static constexpr std::array<const char *, SPAN_COUNT> SPAN_NAMES{
+        "Sensor Read", "Formatting", "LCD Update", "MQTT Publish", "MQTT Yield", "NTP Sync"};
+
+    struct Statistics_t
+    {
+        uint32_t count;
+        uint64_t minimum;   // Cycles.
+        uint64_t maximum;
+        uint64_t total;
+    };
+
+    using Snapshot_t = std::array<Statistics_t, SPAN_COUNT>;
+
+    static void Record(const Span_t & span, const uint64_t & cycles) noexcept
+    {
+        core_util_critical_section_enter();
+        auto & s = s_Statistics[static_cast<size_t>(span)];
+        s.minimum = (s.count == 0) ? cycles : std::min(s.minimum, cycles);
+        s.maximum = std::max(s.maximum, cycles);
+        s.total += cycles;
+        ++s.count;
+        core_util_critical_section_exit();
+    }
+
+    // For spans that cannot be scoped, i.e. that end in another callback.
+    static void RecordSince(const Span_t & span, const uint32_t & startCycles) noexcept
+    {
+        Record(span, CycleCounterClock_t::Cycles() - startCycles);
+    }
+
+    // Consistent across stages, and optionally restarts the statistics so
+    // that each report covers its own interval only.
+    static Snapshot_t TakeSnapshot(const bool & reset = false) noexcept
+    {
+        core_util_critical_section_enter();
+        const auto snapshot = s_Statistics;
+        if (reset)
+        {
+            s_Statistics = Snapshot_t{};
+        }
+        core_util_critical_section_exit();
+
+        return snapshot;
+    }
+
+private:
+    static inline Snapshot_t s_Statistics{};
+};
+
+class ScopedSpan
+{
+public:
+    explicit ScopedSpan(const Span_t & span) noexcept
+        : m_TheSpan(span)
+        , m_TheStartCycles(CycleCounterClock_t::Cycles())
+    {
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+    ~ScopedSpan() { SpanTracer::RecordSince(m_TheSpan, m_TheStartCycles); }
+
+private:
+    Span_t   m_TheSpan;
+    uint32_t m_TheStartCycles;
+};
+
+// For spans that may outlast the cycle counter's wrap period.
+class ScopedKernelSpan
+{
+public:
+    explicit ScopedKernelSpan(const Span_t & span) noexcept
+        : m_TheSpan(span)
+        , m_TheStartTime(Kernel::Clock::now())
+    {
+    }
+
+    ScopedKernelSpan(const ScopedKernelSpan&) = delete;
+    ScopedKernelSpan& operator=(const ScopedKernelSpan&) = delete;
+
+    ~ScopedKernelSpan()
+    {
+        const auto elapsed = std::chrono::duration_cast<CycleCounterClock_t::duration>(Kernel::Clock::now() - m_TheStartTime);
+        SpanTracer::Record(m_TheSpan, static_cast<uint64_t>(elapsed.count()));
+    }
+
+private:
+    Span_t                    m_TheSpan;
+    Kernel::Clock::time_point m_TheStartTime;
+};
@@ -0,0 +1,95 @@
+/***********************************************************************
+* @file      NuerteyTLSSocket.h
+*
+*    A TCPSocket that optionally runs TLS over itself, resuming the
+*    previous session on reconnect instead of renegotiating afresh.
+*
+* @brief   A full handshake costs the MCU a certificate chain verification
+*          and a key exchange, i.e. seconds of CPU at 216MHz and several
+*          round trips. An abbreviated one (RFC 5077 session ticket, or a
+*          session ID cached by the broker) costs one round trip and a few
+*          symmetric operations. The session of the last good handshake
+*          is kept in RAM and offered on every subsequent connect(); should
+*          the broker decline it, the handshake simply proceeds in full.
+*
+* @note    - Until EnableTLS() has succeeded, this is a plain TCPSocket.
+*          - Being a TCPSocket, it can be handed to the Paho MQTTClient and
+*            to anything else that sends and receives on TCPSocket's as is.
+*          - Mbed's own TLSSocket affords no hook between mbedtls_ssl_setup()
+*            and the handshake, which is where mbedtls_ssl_set_session()
+*            must go; hence mbedtls is driven directly here.
+*
+* @warning   mbedtls allocates its record buffers (MBEDTLS_SSL_MAX_CONTENT_LEN
+*            each way) on the heap at EnableTLS(), and the handshake needs
+*            several KB of stack; size the connecting thread accordingly.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include "mbed.h"
+#include "TCPSocket.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/x509_crt.h"
+
+class NuerteyTLSSocket : public TCPSocket
+{
+public:
+    static constexpr std::chrono::milliseconds TLS_HANDSHAKE_TIMEOUT{30000};
+
+    NuerteyTLSSocket();
+
+    NuerteyTLSSocket(const NuerteyTLSSocket&) = delete;
+    NuerteyTLSSocket& operator=(const NuerteyTLSSocket&) = delete;
+
+    virtual ~NuerteyTLSSocket();
+
+    // Once only, before the first connect(). rootCA is PEM and must
+    // outlive the socket; hostname is checked against the certificate.
+    bool EnableTLS(const char * rootCA, const char * hostname);
+
+    bool IsSecure() const { return m_IsSecure; }
+
+    // Handshakes overall, and of those the ones that resumed a session.
+    uint32_t GetHandshakeCount() const { return m_TheHandshakeCount; }
+    uint32_t GetResumedHandshakeCount() const { return m_TheResumedHandshakeCount; }
+
+    // Should the broker's credentials change, say.
+    void ForgetSession();
+
+    // Should the broker move, say; from the next connect() on.
+    bool SetHostname(const char * hostname);
+
+    nsapi_error_t connect(const SocketAddress & address) override;
+    nsapi_error_t close() override;
+    nsapi_size_or_error_t send(const void * data, nsapi_size_t size) override;
+    nsapi_size_or_error_t recv(void * data, nsapi_size_t size) override;
+
+private:
+    nsapi_error_t Handshake();
+
+    static int SendCallback(void * context, const unsigned char * buffer, size_t length);
+    static int ReceiveCallback(void * context, unsigned char * buffer, size_t length);
+
+    bool                     m_IsSecure;
+    bool                     m_IsHandshakeComplete;
+    bool                     m_IsSessionCached;
+
+    mbedtls_entropy_context  m_TheEntropy;
+    mbedtls_ctr_drbg_context m_TheRandomGenerator;
+    mbedtls_x509_crt         m_TheRootCA;
+    mbedtls_ssl_config       m_TheConfiguration;
+    mbedtls_ssl_context      m_TheContext;
+    mbedtls_ssl_session      m_TheSession;
+
+    uint32_t                 m_TheHandshakeCount;
+    uint32_t                 m_TheResumedHandshakeCount;
+};
@@ -0,0 +1,222 @@
+/***********************************************************************
+* @file      NuerteyTelemetryCodec.h
+*
+*    Compact binary encoding of batched sensor telemetry.
+*
+* @brief   Shrink each sample from a dozen or so decimal text bytes down
+*          to 5 bytes so that hundreds of samples fit into one MQTT packet.
+*
+* @note    A frame is laid out as follows. All multi-byte integers are
+*          little-endian:
+*
+*          offset  size  field
+*          0       1     FORMAT_VERSION (currently 1)
+*          1       4     t0, unsigned epoch seconds of the 1st sample
+*          5       5..9  1st sample
+*          ...           further samples, each:
+*
+*                  1..5  dt, seconds since the previous sample (or since
+*                        t0 for the 1st sample, hence always 0), as an
+*                        unsigned LEB128 varint
+*                  2     temperature, int16 degrees Celsius x10
+*                  2     humidity, uint16 %RH x10
+*
+*          The sample count is implied by the frame length. Should the
+*          clock ever step backwards (i.e. NTP), dt is clamped to 0.
+*
+*          FORMAT_VERSION_MILLISECONDS (2) frames are laid out alike, save
+*          for t0 being epoch milliseconds in 6 bytes (good until the year
+*          10889) and dt being milliseconds; samples are hence 6..9 bytes
+*          apart from the 1st:
+*
+*          offset  size  field
+*          0       1     FORMAT_VERSION_MILLISECONDS
+*          1       6     t0, unsigned epoch milliseconds of the 1st sample
+*          7       5..9  1st sample, then further samples as above
+*
+* @warning   Keep this to standard C++; host/Benchmarks.cpp encodes and
+*            decodes frames with it.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace TelemetryCodec
+{
+    static constexpr uint8_t FORMAT_VERSION     = 1;
+    static constexpr uint8_t FORMAT_VERSION_MILLISECONDS = 2;
+    static constexpr size_t  HEADER_BYTES       = 5;
+    static constexpr size_t  MINIMUM_SAMPLE_BYTES = 5;
+    static constexpr size_t  MAXIMUM_SAMPLE_BYTES = 9;
+    static constexpr size_t  EPOCH_MILLISECONDS_BYTES = 6;
+    static constexpr size_t  MILLISECONDS_HEADER_BYTES = 1 + EPOCH_MILLISECONDS_BYTES;
+
+    struct Sample_t
+    {
+        uint32_t delta;
+        int16_t  temperature_x10;
+        uint16_t humidity_x10;
+    };
+
+    // Each Encode*() returns the number of bytes written, or 0 if the
+    // buffer is too small in which case nothing at all is written.
+    constexpr size_t EncodeHeader(std::span<uint8_t> buffer, const uint32_t & baseTimestamp)
+    {
+        if (buffer.size() < HEADER_BYTES)
+        {
+            return 0;
+        }
+
+        buffer[0] = FORMAT_VERSION;
+        for (size_t i = 0; i < 4; i++)
+        {
+            buffer[1 + i] = static_cast<uint8_t>(baseTimestamp >> (8 * i));
+        }
+        return HEADER_BYTES;
+    }
+
+    constexpr size_t EncodeEpochMilliseconds(std::span<uint8_t> buffer, const uint64_t & epochMilliseconds)
+    {
+        if ((buffer.size() < EPOCH_MILLISECONDS_BYTES) || (epochMilliseconds >> (8 * EPOCH_MILLISECONDS_BYTES)))
+        {
+            return 0;
+        }
+
+        for (size_t i = 0; i < EPOCH_MILLISECONDS_BYTES; i++)
+        {
+            buffer[i] = static_cast<uint8_t>(epochMilliseconds >> (8 * i));
+        }
+        return EPOCH_MILLISECONDS_BYTES;
+    }
+
+    constexpr size_t EncodeMillisecondsHeader(std::span<uint8_t> buffer, const uint64_t & baseTimestamp)
+    {
+        if ((buffer.size() < MILLISECONDS_HEADER_BYTES)
+            || (EncodeEpochMilliseconds(buffer.subspan(1), baseTimestamp) == 0))
+        {
+            return 0;
+        }
+
+        buffer[0] = FORMAT_VERSION_MILLISECONDS;
+        return MILLISECONDS_HEADER_BYTES;
+    }
+
+    constexpr size_t EncodeSample(std::span<uint8_t> buffer, const Sample_t & sample)
+    {
+        uint8_t varint[5] = {};
+        size_t length = 0;
+        uint32_t delta = sample.delta;
+        do
+        {
+            varint[length] = static_cast<uint8_t>(delta & 0x7F);
+            delta >>= 7;
+            if (delta)
+            {
+                varint[length] |= 0x80;
+            }
+            ++length;
+        }
+        while (delta);
+
+        if (buffer.size() < (length + 4))
+        {
+            return 0;
+        }
+
+        for (size_t i = 0; i < length; i++)
+        {
+            buffer[i] = varint[i];
+        }
+
+        const auto temperature = static_cast<uint16_t>(sample.temperature_x10);
+        buffer[length]     = static_cast<uint8_t>(temperature);
+        buffer[length + 1] = static_cast<uint8_t>(temperature >> 8);
+        buffer[length + 2] = static_cast<uint8_t>(sample.humidity_x10);
+        buffer[length + 3] = static_cast<uint8_t>(sample.humidity_x10 >> 8);
+
+        return (length + 4);
+    }
+
+    // Reference decoder, the mirror image of the above. Returns the number
+    // of bytes consumed from buffer, or 0 if it is truncated or malformed.
+    constexpr size_t DecodeHeader(std::span<const uint8_t> buffer, uint32_t & baseTimestamp)
+    {
+        if ((buffer.size() < HEADER_BYTES) || (buffer[0] != FORMAT_VERSION))
+        {
+            return 0;
+        }
+
+        baseTimestamp = 0;
+        for (size_t i = 0; i < 4; i++)
+        {
+            baseTimestamp |= static_cast<uint32_t>(buffer[1 + i]) << (8 * i);
+        }
+        return HEADER_BYTES;
+    }
+
+    constexpr size_t DecodeEpochMilliseconds(std::span<const uint8_t> buffer, uint64_t & epochMilliseconds)
+    {
+        if (buffer.size() < EPOCH_MILLISECONDS_BYTES)
+        {
+            return 0;
+        }
+
+        epochMilliseconds = 0;
+        for (size_t i = 0; i < EPOCH_MILLISECONDS_BYTES; i++)
+        {
+            epochMilliseconds |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+        }
+        return EPOCH_MILLISECONDS_BYTES;
+    }
+
+    constexpr size_t DecodeMillisecondsHeader(std::span<const uint8_t> buffer, uint64_t & baseTimestamp)
+    {
+        if ((buffer.size() < MILLISECONDS_HEADER_BYTES) || (buffer[0] != FORMAT_VERSION_MILLISECONDS))
+        {
+            return 0;
+        }
+
+        return (1 + DecodeEpochMilliseconds(buffer.subspan(1), baseTimestamp));
+    }
+
+    constexpr size_t DecodeSample(std::span<const uint8_t> buffer, Sample_t & sample)
+    {
+        size_t length = 0;
+        uint32_t delta = 0;
+        for (;;)
+        {
+            if ((length >= buffer.size()) || (length >= 5))
+            {
+                return 0;
+            }
+
+            const auto byte = buffer[length];
+            delta |= static_cast<uint32_t>(byte & 0x7F) << (7 * length);
+            ++length;
+
+            if (!(byte & 0x80))
+            {
+                break;
+            }
+        }
+
+        if (buffer.size() < (length + 4))
+        {
+            return 0;
+        }
+
+        sample.delta = delta;
+        sample.temperature_x10 = static_cast<int16_t>(buffer[length] | (buffer[length + 1] << 8));
+        sample.humidity_x10 = static_cast<uint16_t>(buffer[length + 2] | (buffer[length + 3] << 8));
+
+        return (length + 4);
+    }
+} // namespace TelemetryCodec
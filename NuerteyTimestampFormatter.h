@@ -0,0 +1,121 @@
+/***********************************************************************
+* @file      NuerteyTimestampFormatter.h
+*
+*    ISO-8601 formatting of epoch milliseconds, e.g.:
+*
+*        2026-10-14T12:34:56.789Z
+*
+* @brief   The civil date is what costs, whether by way of std::gmtime()
+*          or of Date.h's civil_from_days(). It changes but once a day,
+*          hence each formatter caches the current day's "YYYY-MM-DDT"
+*          prefix and where that day starts. Within the day, only
+*          hh:mm:ss.mmm is derived afresh, with 32-bit arithmetic and no
+*          64-bit divisions, straight into the caller's buffer.
+*
+* @note    - UTC only. Mbed has no notion of time zones; localtime() is UTC.
+*          - Years are written as 4 digits, clamped to 0000..9999.
+*          - Nothing is allocated, nor are there any locks. A formatter
+*            is hence not to be shared between threads; have one each.
+*
+* @warning   host/Benchmarks.cpp builds this against gmtime_r(), hence
+*            libc and the standard library only.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include "Date.h"
+
+class TimestampFormatter
+{
+public:
+    static constexpr size_t ISO8601_LENGTH = 24;
+
+    TimestampFormatter() = default;
+
+    TimestampFormatter(const TimestampFormatter&) = delete;
+    TimestampFormatter& operator=(const TimestampFormatter&) = delete;
+
+    // Null-terminated; returns the length sans the terminator.
+    template <size_t N>
+    size_t Format(std::array<char, N> & buffer, const int64_t & epochMilliseconds)
+    {
+        static_assert(N > ISO8601_LENGTH,
+        "Hey! The buffer must hold an ISO-8601 timestamp and its terminator!!");
+
+        if ((epochMilliseconds < m_TheDayStart) || (epochMilliseconds >= (m_TheDayStart + MILLISECONDS_PER_DAY)))
+        {
+            CacheDay(epochMilliseconds);
+        }
+
+        // Less than a day's worth, hence 32 bits suffice from here on.
+        const auto milliseconds = static_cast<uint32_t>(epochMilliseconds - m_TheDayStart);
+        const auto seconds = milliseconds / 1000;
+
+        char * p = buffer.data();
+        std::copy(m_ThePrefix.begin(), m_ThePrefix.end(), p);
+        WriteTwoDigits(p + 11, seconds / 3600);
+        p[13] = ':';
+        WriteTwoDigits(p + 14, (seconds / 60) % 60);
+        p[16] = ':';
+        WriteTwoDigits(p + 17, seconds % 60);
+        p[19] = '.';
+        const auto fraction = milliseconds % 1000;
+        p[20] = static_cast<char>('0' + (fraction / 100));
+        WriteTwoDigits(p + 21, fraction % 100);
+        p[23] = 'Z';
+        p[24] = '\0';
+
+        return ISO8601_LENGTH;
+    }
+
+private:
+    static constexpr int64_t MILLISECONDS_PER_DAY = 86'400'000;
+
+    static void WriteTwoDigits(char * p, const uint32_t & value)
+    {
+        static constexpr char DIGIT_PAIRS[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        p[0] = DIGIT_PAIRS[2 * value];
+        p[1] = DIGIT_PAIRS[(2 * value) + 1];
+    }
+
+    void CacheDay(const int64_t & epochMilliseconds)
+    {
+        // Floored, so that instants before the epoch fall on the day before.
+        auto day = epochMilliseconds / MILLISECONDS_PER_DAY;
+        if ((epochMilliseconds % MILLISECONDS_PER_DAY) < 0)
+        {
+            --day;
+        }
+
+        const date::year_month_day civil{date::sys_days{date::days{static_cast<int32_t>(day)}}};
+        const auto year = static_cast<uint32_t>(std::clamp(static_cast<int>(civil.year()), 0, 9999));
+
+        WriteTwoDigits(m_ThePrefix.data(), year / 100);
+        WriteTwoDigits(m_ThePrefix.data() + 2, year % 100);
+        m_ThePrefix[4] = '-';
+        WriteTwoDigits(m_ThePrefix.data() + 5, static_cast<unsigned>(civil.month()));
+        m_ThePrefix[7] = '-';
+        WriteTwoDigits(m_ThePrefix.data() + 8, static_cast<unsigned>(civil.day()));
+        m_ThePrefix[10] = 'T';
+
+        m_TheDayStart = day * MILLISECONDS_PER_DAY;
+    }
+
+    // Nothing is cached until the first Format().
+    int64_t               m_TheDayStart{std::numeric_limits<int64_t>::max() - MILLISECONDS_PER_DAY};
+    std::array<char, 11>  m_ThePrefix{};
+};
@@ -0,0 +1,37 @@
+/***********************************************************************
+* @file      NuerteyTypeTraits.h
+*
+*    Type traits, and conversions between enumerations and their
+*    underlying integers.
+*
+* @brief   Split out of Utilities.h so that the sensor driver need not
+*          drag in the network stack along with them.
+*
+* @warning   NuerteyDHT11Device.h includes this in the host build too,
+*            where there is no mbed.h beyond host/shims.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <type_traits>
+
+template <typename T, typename U>
+struct TrueTypesEquivalent : std::is_same<typename std::decay<T>::type, U>::type
+{};
+
+template <typename E>
+constexpr auto ToUnderlyingType(E e) -> typename std::underlying_type<E>::type
+{
+    return static_cast<typename std::underlying_type<E>::type>(e);
+}
+
+template <typename E, typename V = unsigned long>
+constexpr auto ToEnum(V value) -> E
+{
+    return static_cast<E>(value);
+}
@@ -26,6 +26,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstdint>
+#include <cmath>
 #include <cassert>
 #include <memory>
 #include <utility> 
@@ -40,18 +41,27 @@
 #include <array>
 #include <tuple>
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <charconv>
+#include <span>
 #include "Date.h"
+#include "NuerteyTypeTraits.h"
+#include "NuerteyFormatters.h"
+#include "NuerteyNetworkErrors.h"
 #include "jwt-mbed.h"
 #include "nsapi_types.h"
 #include "EthernetInterface.h"
 #include "MQTTClient.h"
 #include "NuerteyNTPClient.h"
+#include "NuerteyLogger.h"
 //#include "mbed_mem_trace.h"
 #include "randLIB.h"
 #include "mbed_events.h"   // thread and irq safe
 #include "mbed.h"
 #include "TCPSocket.h"
+#include "NuerteyTLSSocket.h"
+#include "NuerteySpanTracer.h"
 
 #if !defined(MBED_SYS_STATS_ENABLED)
 #error "[NOT_SUPPORTED] MBED System Statistics Not Enabled"
@@ -61,6 +71,14 @@
 #error "[NOT_SUPPORTED] MBED Heap Statistics Not Enabled"
 #endif
 
+#if !defined(MBED_CPU_STATS_ENABLED)
+#error "[NOT_SUPPORTED] MBED CPU Statistics Not Enabled"
+#endif
+
+#if !defined(MBED_STACK_STATS_ENABLED)
+#error "[NOT_SUPPORTED] MBED Stack Statistics Not Enabled"
+#endif
+
 #if !defined(MBED_CONF_NSAPI_SOCKET_STATS_ENABLED)
 #error "[NOT_SUPPORTED] Socket Statistics not supported"
 #endif
@@ -79,153 +97,6 @@ using DoubleSecs_t          = std::chrono::duration<double>;
 using FloatingMilliSecs_t   = std::chrono::duration<double, std::milli>;
 using FloatingMicroSecs_t   = std::chrono::duration<double, std::micro>;
 
-// 1 minute of failing to exchange packets with the Broker ought
-// to be enough to tell us that there is something wrong with the socket.
-static constexpr int32_t BLOCKING_SOCKET_TIMEOUT_MILLISECONDS{60000};
-
-enum class MQTTConnectionError_t : int8_t
-{
-    SUCCESS_NO_ERROR                 = 0,
-    UNACCEPTABLE_PROTOCOL_VERSION    = 1,
-    IDENTIFIER_REJECTED              = 2,
-    SERVER_UNAVAILABLE               = 3,
-    BAD_USER_NAME_OR_PASSWORD        = 4,
-    NOT_AUTHORIZED                   = 5,
-    RESERVED                         = 6,
-    MQTTCLIENT_FAILURE               = -1,
-    MQTTCLIENT_DISCONNECTED          = -3,
-    MQTTCLIENT_MAX_MESSAGES_INFLIGHT = -4,
-    MQTTCLIENT_BAD_UTF8_STRING       = -5,
-    MQTTCLIENT_NULL_PARAMETER        = -6,
-    MQTTCLIENT_TOPICNAME_TRUNCATED   = -7,
-    MQTTCLIENT_BAD_STRUCTURE         = -8,
-    MQTTCLIENT_BAD_QOS               = -9,
-    MQTTCLIENT_SSL_NOT_SUPPORTED     = -10,
-    MQTTCLIENT_BAD_MQTT_VERSION      = -11,
-    MQTTCLIENT_BAD_PROTOCOL          = -14,
-    MQTTCLIENT_BAD_MQTT_OPTION       = -15,
-    MQTTCLIENT_WRONG_MQTT_VERSION    = -16
-};
-
-using MQTTConnectionErrorMap_t = std::map<MQTTConnectionError_t, std::string>;
-using IndexElementMQTT_t       = MQTTConnectionErrorMap_t::value_type;
-
-inline static auto make_mqtt_connection_error_map()
-{
-    MQTTConnectionErrorMap_t eMap;
-    
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::SUCCESS_NO_ERROR, std::string("\"Connection succeeded: no errors\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::UNACCEPTABLE_PROTOCOL_VERSION, std::string("\"Connection refused: Unacceptable protocol version\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::IDENTIFIER_REJECTED, std::string("\"Connection refused: Identifier rejected\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::SERVER_UNAVAILABLE, std::string("\"Connection refused: Server unavailable\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::BAD_USER_NAME_OR_PASSWORD, std::string("\"Connection refused: Bad user name or password\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::NOT_AUTHORIZED, std::string("\"Connection refused: Not authorized\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::RESERVED, std::string("\"Reserved for future use\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_FAILURE, std::string("\"Generic MQTT client operation failure\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_DISCONNECTED, std::string("\"The client is disconnected.\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_MAX_MESSAGES_INFLIGHT, std::string("\"The maximum number of messages allowed to be simultaneously in-flight has been reached.\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_UTF8_STRING, std::string("\"An invalid UTF-8 string has been detected.\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_NULL_PARAMETER, std::string("\"A NULL parameter has been supplied when this is invalid.\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_TOPICNAME_TRUNCATED, std::string("\"The topic has been truncated (the topic string includes embedded NULL characters). String functions will not access the full topic. Use the topic length value to access the full topic.\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_STRUCTURE, std::string("\"A structure parameter does not have the correct eyecatcher and version number.\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_QOS, std::string("\"A QoS value that falls outside of the acceptable range (0,1,2)\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_SSL_NOT_SUPPORTED, std::string("\"Attempting SSL connection using non-SSL version of library\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_MQTT_VERSION, std::string("\"unrecognized MQTT version\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_PROTOCOL, std::string("\"protocol prefix in serverURI should be tcp:// or ssl://\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_BAD_MQTT_OPTION, std::string("\"option not applicable to the requested version of MQTT\"")));
-    eMap.insert(IndexElementMQTT_t(MQTTConnectionError_t::MQTTCLIENT_WRONG_MQTT_VERSION, std::string("\"call not applicable to the requested version of MQTT\"")));
-
-    return eMap;
-}
-
-static MQTTConnectionErrorMap_t gs_MQTTConnectionErrorMap_t = make_mqtt_connection_error_map();
-
-inline std::string ToString(const MQTTConnectionError_t & key)
-{    
-    std::string result;
-
-    // Prevent the possibility of std::out_of_range exception if the container
-    // does not have an error element with the specified key.
-    auto iter = gs_MQTTConnectionErrorMap_t.find(key);     
-    if (iter != gs_MQTTConnectionErrorMap_t.end())
-    {
-        result = iter->second;
-    }
-    else
-    {
-        result = std::string("\"Warning! Code does not indicate an error and consequently does not exist in gs_MQTTConnectionErrorMap_t!\"");
-    }
-    
-    return result;
-}
-
-using ErrorCodesMap_t = std::map<nsapi_size_or_error_t, std::string>;
-using IndexElement_t  = ErrorCodesMap_t::value_type;
-
-inline static auto make_error_codes_map()
-{
-    ErrorCodesMap_t eMap;
-    
-    eMap.insert(IndexElement_t(NSAPI_ERROR_OK, std::string("\"no error\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_WOULD_BLOCK, std::string("\"no data is not available but call is non-blocking\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_UNSUPPORTED, std::string("\"unsupported functionality\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_PARAMETER, std::string("\"invalid configuration\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_CONNECTION, std::string("\"not connected to a network\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_SOCKET, std::string("\"socket not available for use\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_ADDRESS, std::string("\"IP address is not known\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_MEMORY, std::string("\"memory resource not available\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_NO_SSID, std::string("\"ssid not found\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_DNS_FAILURE, std::string("\"DNS failed to complete successfully\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_DHCP_FAILURE, std::string("\"DHCP failed to complete successfully\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_AUTH_FAILURE, std::string("\"connection to access point failed\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_DEVICE_ERROR, std::string("\"failure interfacing with the network processor\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_IN_PROGRESS, std::string("\"operation (eg connect) in progress\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_ALREADY, std::string("\"operation (eg connect) already in progress\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_IS_CONNECTED, std::string("\"socket is already connected\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_CONNECTION_LOST, std::string("\"connection lost\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_CONNECTION_TIMEOUT, std::string("\"connection timed out\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_ADDRESS_IN_USE, std::string("\"Address already in use\"")));
-    eMap.insert(IndexElement_t(NSAPI_ERROR_TIMEOUT, std::string("\"operation timed out\"")));    
-    return eMap;
-}
-
-static ErrorCodesMap_t gs_ErrorCodesMap = make_error_codes_map();
-
-inline std::string ToString(const nsapi_size_or_error_t & key)
-{
-    std::string result;
-
-    // Prevent the possibility of std::out_of_range exception if the container
-    // does not have an error element with the specified key.
-    auto iter = gs_ErrorCodesMap.find(key);     
-    if (iter != gs_ErrorCodesMap.end())
-    {
-        result = iter->second;
-    }
-    else
-    {
-        result = std::string("\"Warning! Code does not indicate an error and consequently does not exist in gs_ErrorCodesMap!\"");
-    }
-    
-    return result;
-}
-    
-template <typename T, typename U>
-struct TrueTypesEquivalent : std::is_same<typename std::decay<T>::type, U>::type
-{};
-
-template <typename E>
-constexpr auto ToUnderlyingType(E e) -> typename std::underlying_type<E>::type
-{
-    return static_cast<typename std::underlying_type<E>::type>(e);
-}
-
-template <typename E, typename V = unsigned long>
-constexpr auto ToEnum(V value) -> E
-{
-    return static_cast<E>(value);
-}
-
 //void DisplayLCDCapabilities();
 bool InitializeSocket(const std::string & server, const uint16_t & port);
 void DHT11SensorAcquisition();
@@ -240,13 +111,12 @@ namespace Utility
     extern EventQueue *                     g_pMasterEventQueue;
 
     extern size_t                           g_MessageLength;
-    extern std::unique_ptr<MQTT::Message>   g_pMessage;
 
     extern PlatformMutex                    g_STDIOMutex;
     extern EthernetInterface                g_EthernetInterface;
     extern NetworkInterface *               g_pNetworkInterface;
     
-    extern TCPSocket                        m_TheSocket; // This must definitely precede the MQTT client.
+    extern NuerteyTLSSocket                 m_TheSocket; // This must definitely precede the MQTT client.
     extern SocketAddress                    m_TheSocketAddress;
     
     extern NuerteyNTPClient                 g_NTPClient;
@@ -255,6 +125,8 @@ namespace Utility
     bool InitializeGlobalResources();
     void ReleaseGlobalResources();
     void DisplayStatistics();
+    void DisplaySpanStatistics();
+    void ReportStackUsage();
     void RetrieveNTPTime();
 
     // This custom clock type obtains the time from RTC too whilst noting the Processor speed.
@@ -290,6 +162,9 @@ namespace Utility
     //
     // auto t = Utility::NucleoF767ZIClock_t::now();  // a chrono::time_point
     //
+    // CAUTION: Only ever as fine as the RTC's whole seconds. To time
+    // anything shorter, use CycleCounterClock_t instead.
+    //
     // and
     //
     // auto d = Utility::NucleoF767ZIClock_t::now() - t;  // a chrono::duration
@@ -304,6 +179,8 @@ namespace Utility
         return tempTimepoint;
     };
 
+    // Each call allocates; per-sample timestamps are better off formatted
+    // by a TimestampFormatter (see NuerteyTimestampFormatter.h).
     const auto WhatTimeNow = []()
     {
         char buffer[32];
@@ -335,34 +212,6 @@ namespace Utility
         return x < 0? -static_cast<decltype(abs(x))>(x) : x;
     }
 
-    template <typename T>
-    constexpr auto TruncateAndToString = [](const T& x, const int& decimalDigits)
-    {
-        std::stringstream ss;
-        ss << std::fixed;
-        ss.precision(decimalDigits);
-        ss << x;
-        return ss.str();
-    };
-    
-    const auto TemperatureToString = [](const float& temperature)
-    {
-        std::ostringstream oss;  
-        oss << std::fixed;
-        oss.precision(2);
-        oss << "Temp: " << temperature << " F";
-        return oss.str();
-    };
-    
-    const auto HumidityToString = [](const float& humidity)
-    {
-        std::ostringstream oss;  
-        oss << std::fixed;
-        oss.precision(2);
-        oss << "Humi: " << humidity << " % RH";
-        return oss.str();
-    };
-
     template <typename E>
     constexpr auto ToIntegral(E e) -> typename std::underlying_type<E>::type
     {
@@ -425,11 +274,11 @@ namespace Utility
                 // and Development build profiles and not in the Release build profile. 
                 MBED_ASSERT(pInterface);
 
-                printf("Performing DNS lookup for : \"%s\" ...\n", address.c_str());
+                LOG_INFO("Performing DNS lookup for : \"%s\" ...\n", address.c_str());
                 nsapi_error_t retVal = pInterface->gethostbyname(address.c_str(), pTheSocketAddress);
                 if (retVal < 0)
                 {
-                    printf("Error! On DNS lookup, Network returned: [%d] -> %s\n", retVal, ToString(retVal).c_str());
+                    LOG_ERROR("Error! On DNS lookup, Network returned: [%d] -> %s\n", retVal, ToString(retVal).c_str());
                 }
                 else
                 {
@@ -477,10 +326,10 @@ namespace Utility
     {
         auto [ip, netmask, gateway, mac] = GetNetworkInterfaceProfile(g_pNetworkInterface);
         
-        printf("Particular Network Interface IP address: %s\n", ip.value_or("(null)"));
-        printf("Particular Network Interface Netmask: %s\n", netmask.value_or("(null)"));
-        printf("Particular Network Interface Gateway: %s\n", gateway.value_or("(null)"));
-        printf("Particular Network Interface MAC Address: %s\n", mac.value_or("(null)"));
+        LOG_INFO("Particular Network Interface IP address: %s\n", ip.value_or("(null)"));
+        LOG_INFO("Particular Network Interface Netmask: %s\n", netmask.value_or("(null)"));
+        LOG_INFO("Particular Network Interface Gateway: %s\n", gateway.value_or("(null)"));
+        LOG_INFO("Particular Network Interface MAC Address: %s\n", mac.value_or("(null)"));
         
         std::string ipString = ip.value_or("(null)");
         std::string netmaskString = netmask.value_or("(null)");
@@ -0,0 +1,188 @@
+/***********************************************************************
+* @file      AggregatorCheck.cpp
+*
+*    Checks RollingWindow's incremental summaries against ones reduced
+*    afresh, by brute force, from the very readings within the window.
+*
+* @brief   Pseudo-random readings are fed at irregular intervals, with
+*          gaps longer than the window and a backwards clock step, into
+*          windows both wider and narrower than their CAPACITY, so that
+*          readings are evicted by age and by count alike. After every
+*          reading, the count, minimum, maximum, mean and standard
+*          deviation of both channels must agree.
+*
+* @code
+*   aggregator_check
+* @endcode
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 15, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <algorithm>
+#include "NuerteyReadingsAggregator.h"
+
+namespace
+{
+    constexpr size_t  READINGS  = 20000;
+    constexpr double  TOLERANCE = 1e-3;
+
+    struct Reading_t
+    {
+        time_t   timestamp;
+        int16_t  temperature_x10;
+        uint16_t humidity_x10;
+    };
+
+    // As RollingWindow evicts: by count beyond N, else by age.
+    template <size_t N>
+    class BruteForceWindow
+    {
+    public:
+        explicit BruteForceWindow(const uint32_t & windowSeconds) : m_WindowSeconds(windowSeconds) {}
+
+        void Add(const Reading_t & reading)
+        {
+            if (!m_Readings.empty() && (reading.timestamp < m_Readings.back().timestamp))
+            {
+                m_Readings.clear();
+            }
+
+            while (!m_Readings.empty() && ((m_Readings.size() >= N)
+                || ((reading.timestamp - m_Readings.front().timestamp) >= static_cast<time_t>(m_WindowSeconds))))
+            {
+                m_Readings.pop_front();
+            }
+
+            m_Readings.push_back(reading);
+        }
+
+        size_t GetCount() const { return m_Readings.size(); }
+
+        template <typename F>
+        Aggregation::ChannelStatistics_t GetStatistics(F field) const
+        {
+            Aggregation::ChannelStatistics_t statistics{};
+            statistics.minimum_x10 = std::numeric_limits<int16_t>::max();
+            statistics.maximum_x10 = std::numeric_limits<int16_t>::min();
+
+            double sum = 0.0;
+            for (const auto & reading : m_Readings)
+            {
+                const auto value = static_cast<int16_t>(field(reading));
+                statistics.minimum_x10 = std::min(statistics.minimum_x10, value);
+                statistics.maximum_x10 = std::max(statistics.maximum_x10, value);
+                sum += value / 10.0;
+            }
+
+            const auto count = static_cast<double>(m_Readings.size());
+            const auto mean = sum / count;
+
+            double squares = 0.0;
+            for (const auto & reading : m_Readings)
+            {
+                squares += std::pow((field(reading) / 10.0) - mean, 2);
+            }
+
+            statistics.mean = static_cast<float>(mean);
+            statistics.standardDeviation = (m_Readings.size() > 1) ? static_cast<float>(std::sqrt(squares / (count - 1))) : 0.0f;
+            return statistics;
+        }
+
+    private:
+        uint32_t              m_WindowSeconds;
+        std::deque<Reading_t> m_Readings;
+    };
+
+    int Compare(const char * name, const size_t & index, const char * channel,
+                const Aggregation::ChannelStatistics_t & actual, const Aggregation::ChannelStatistics_t & expected)
+    {
+        const bool isEqual = (actual.minimum_x10 == expected.minimum_x10)
+                          && (actual.maximum_x10 == expected.maximum_x10)
+                          && (std::fabs(actual.mean - expected.mean) <= TOLERANCE)
+                          && (std::fabs(actual.standardDeviation - expected.standardDeviation) <= TOLERANCE);
+        if (!isEqual)
+        {
+            std::fprintf(stderr, "Error! %s, reading [%zu], %s: min %d max %d mean %.4f stddev %.4f,"
+                         " expected min %d max %d mean %.4f stddev %.4f.\n", name, index, channel,
+                         actual.minimum_x10, actual.maximum_x10, actual.mean, actual.standardDeviation,
+                         expected.minimum_x10, expected.maximum_x10, expected.mean, expected.standardDeviation);
+        }
+        return isEqual ? 0 : 1;
+    }
+
+    template <size_t N>
+    int Check(const char * name, const uint32_t & windowSeconds, const uint32_t & seed)
+    {
+        RollingWindow<N> window(windowSeconds);
+        BruteForceWindow<N> expected(windowSeconds);
+
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> interval(1, 6);
+        std::uniform_int_distribution<int> temperature(-100, 500);
+        std::uniform_int_distribution<int> humidity(200, 900);
+        std::uniform_int_distribution<int> event(0, 999);
+
+        time_t timestamp = 1'760'000'000;
+        int failures = 0;
+
+        for (size_t i = 0; (i < READINGS) && (failures < 10); i++)
+        {
+            const auto roll = event(generator);
+            if (roll == 0)
+            {
+                timestamp += 2 * windowSeconds; // Acquisition stalled.
+            }
+            else if (roll == 1)
+            {
+                timestamp -= 30;                // NTP stepped the clock back.
+            }
+            else
+            {
+                timestamp += interval(generator);
+            }
+
+            const Reading_t reading{timestamp, static_cast<int16_t>(temperature(generator)),
+                                    static_cast<uint16_t>(humidity(generator))};
+            window.Add(reading.timestamp, reading.temperature_x10, reading.humidity_x10);
+            expected.Add(reading);
+
+            const auto summary = window.GetSummary();
+            if (summary.count != expected.GetCount())
+            {
+                std::fprintf(stderr, "Error! %s, reading [%zu]: %u readings in the window, expected %zu.\n",
+                             name, i, summary.count, expected.GetCount());
+                ++failures;
+                continue;
+            }
+
+            failures += Compare(name, i, "temperature", summary.temperature,
+                                expected.GetStatistics([](const Reading_t & r) { return r.temperature_x10; }));
+            failures += Compare(name, i, "humidity", summary.humidity,
+                                expected.GetStatistics([](const Reading_t & r) { return r.humidity_x10; }));
+        }
+
+        std::printf("%s: %zu readings, %s\n", name, READINGS, (failures == 0) ? "passed" : "FAILED");
+        return failures;
+    }
+} // namespace
+
+int main()
+{
+    int failures = 0;
+
+    // Ample capacity, hence evicted by age alone.
+    failures += Check<64>("1 minute, by age", 60, 1);
+
+    // Too little capacity for the window, hence mostly evicted by count.
+    failures += Check<32>("15 minutes, by count", 900, 2);
+
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,297 @@
+/***********************************************************************
+* @file      Benchmarks.cpp
+*
+*    Micro-benchmarks of the per-sample work: frame decode, checksum,
+*    dew point, reading and timestamp formatting and payload encoding.
+*
+* @brief   Each benchmark reports the mean wall-clock time per operation
+*          over a fixed number of iterations, on the host's steady clock.
+*          Absolute figures say little about a 216 MHz Cortex-M7; compare
+*          them across revisions on the one workstation, or against the
+*          baselines reported alongside (libc's gmtime() and snprintf(),
+*          std::ostringstream, and the double precision dew point
+*          reference).
+*
+* @code
+*   benchmarks [--quick] fixtures/clean.edges fixtures/noisy.edges
+* @endcode
+*
+* @note    --quick cuts every iteration count a thousandfold, merely to
+*          smoke test the benchmarks, as ctest does.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+#include "NuerteyDewPoint.h"
+#include "NuerteyFormatters.h"
+#include "NuerteyTelemetryCodec.h"
+#include "NuerteyTimestampFormatter.h"
+#include "EdgeFixture.h"
+
+using Sensor_t = NuerteyDHT11Device<DHT11_t, PE_13>;
+
+namespace
+{
+    size_t gs_TheIterationDivisor = 1;
+
+    // Keeps the compiler from optimizing away whatever value depends on.
+    template <typename T>
+    inline void DoNotOptimize(const T & value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template <typename F>
+    void Benchmark(const char * name, const size_t & iterations, F && operation)
+    {
+        const auto count = std::max<size_t>(iterations / gs_TheIterationDivisor, 1);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++)
+        {
+            operation(i);
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+        std::printf("%-40s %10zu %12.1f ns/op\n", name, count, elapsed.count() / static_cast<double>(count));
+    }
+
+    void BenchmarkDecode(const EdgeFixture::Fixture_t & fixture)
+    {
+        Sensor_t::CapturedEdges_t edges{};
+        const auto count = EdgeFixture::ToCapturedEdges<Sensor_t>(fixture, edges);
+        const auto name = "DecodeCapturedEdges (" + fixture.name + ")";
+
+        Benchmark(name.c_str(), 1'000'000, [&](const size_t &)
+        {
+            Sensor_t::DataFrame_t frame = 0;
+            const auto result = Sensor_t::DecodeCapturedEdges(edges, count, frame);
+            DoNotOptimize(result);
+            DoNotOptimize(frame);
+        });
+    }
+
+    void BenchmarkChecksum()
+    {
+        // Valid and invalid frames alike, so that neither outcome is predicted.
+        std::array<Sensor_t::DataFrame_t, 256> frames{};
+        for (size_t i = 0; i < frames.size(); i++)
+        {
+            const auto humidity = static_cast<uint64_t>(20 + (i % 70));
+            const auto celsius = static_cast<uint64_t>(i % 50);
+            frames[i] = (humidity << 32) | (celsius << 16) | ((humidity + celsius + (i & 1)) & 0xFF);
+        }
+
+        Benchmark("IsChecksumValid", 100'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(Sensor_t::IsChecksumValid(frames[i & 0xFF]));
+        });
+    }
+
+    void BenchmarkDewPoint()
+    {
+        Benchmark("DewPoint::Lookup_x10 (DHT11)", 100'000'000, [](const size_t & i)
+        {
+            DoNotOptimize(DewPoint::Lookup_x10(static_cast<int>(i % 51), static_cast<int>(1 + (i % 100))));
+        });
+
+        Benchmark("DewPoint::Approximate (DHT22)", 100'000'000, [](const size_t & i)
+        {
+            DoNotOptimize(DewPoint::Approximate(static_cast<float>(i % 800) * 0.1f,
+                                                static_cast<float>(1 + (i % 1000)) * 0.1f));
+        });
+
+        Benchmark("DewPoint::Reference (baseline)", 10'000'000, [](const size_t & i)
+        {
+            DoNotOptimize(DewPoint::Reference(static_cast<double>(i % 800) * 0.1,
+                                              static_cast<double>(1 + (i % 1000)) * 0.1));
+        });
+    }
+
+    void BenchmarkReadingFormatting()
+    {
+        // Sweeps the DHT11's range, in tenths as the driver reports it.
+        const auto Temperature = [](const size_t & i) { return 32.0f + static_cast<float>(i % 900) * 0.1f; };
+        const auto Humidity = [](const size_t & i) { return 20.0f + static_cast<float>(i % 700) * 0.1f; };
+
+        // One row of the 16x2 LCD, as the display thread formats it.
+        std::array<char, 17> row{};
+
+        Benchmark("Utility::FormatFixed", 10'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(Utility::FormatFixed(row, Temperature(i), 2));
+        });
+
+        Benchmark("snprintf %.2f (baseline)", 10'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(std::snprintf(row.data(), row.size(), "%.2f", Temperature(i)));
+        });
+
+        Benchmark("Utility::FormatTemperature", 10'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(Utility::FormatTemperature(row, Temperature(i)));
+        });
+
+        Benchmark("Utility::FormatHumidity", 10'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(Utility::FormatHumidity(row, Humidity(i)));
+        });
+
+        Benchmark("snprintf temperature (baseline)", 10'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(std::snprintf(row.data(), row.size(), "Temp: %.2f F", Temperature(i)));
+        });
+
+        Benchmark("ostringstream temperature (baseline)", 1'000'000, [&](const size_t & i)
+        {
+            std::ostringstream stream;
+            stream << "Temp: " << std::fixed << std::setprecision(2) << Temperature(i) << " F";
+            const auto text = stream.str();
+            DoNotOptimize(text.size());
+        });
+    }
+
+    void BenchmarkTimestampFormatting()
+    {
+        // A reading every 3 seconds, hence a new day every 28800 of them.
+        constexpr int64_t BASE_MILLISECONDS = 1'760'000'000'000;
+        std::array<char, TimestampFormatter::ISO8601_LENGTH + 1> buffer{};
+        TimestampFormatter formatter;
+
+        Benchmark("TimestampFormatter::Format", 10'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(formatter.Format(buffer, BASE_MILLISECONDS + (static_cast<int64_t>(i) * 3000)));
+        });
+
+        Benchmark("gmtime_r + snprintf (baseline)", 10'000'000, [&](const size_t & i)
+        {
+            const auto milliseconds = BASE_MILLISECONDS + (static_cast<int64_t>(i) * 3000);
+            const auto seconds = static_cast<time_t>(milliseconds / 1000);
+            struct tm civil{};
+            gmtime_r(&seconds, &civil);
+            DoNotOptimize(std::snprintf(buffer.data(), buffer.size(), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                                        civil.tm_year + 1900, civil.tm_mon + 1, civil.tm_mday, civil.tm_hour,
+                                        civil.tm_min, civil.tm_sec, static_cast<int>(milliseconds % 1000)));
+        });
+    }
+
+    void BenchmarkPayloadEncoding()
+    {
+        // One batch's worth, as NuerteyMQTTClient would encode it.
+        constexpr size_t SAMPLES = 32;
+        constexpr uint64_t BASE_MILLISECONDS = 1'760'000'000'123;
+        std::array<uint8_t, 1024> frame{};
+        std::array<char, 1024> text{};
+
+        const auto EncodeFrame = [&](const bool & isMilliseconds, const size_t & i) -> size_t
+        {
+            std::span<uint8_t> buffer(frame);
+            size_t length = isMilliseconds
+                          ? TelemetryCodec::EncodeMillisecondsHeader(buffer, BASE_MILLISECONDS + i)
+                          : TelemetryCodec::EncodeHeader(buffer, static_cast<uint32_t>((BASE_MILLISECONDS + i) / 1000));
+
+            for (size_t sample = 0; sample < SAMPLES; sample++)
+            {
+                const auto delta = static_cast<uint32_t>((sample == 0) ? 0 : (isMilliseconds ? 3001 : 3));
+                length += TelemetryCodec::EncodeSample(buffer.subspan(length),
+                                                       {delta, static_cast<int16_t>(200 + (sample % 16)),
+                                                        static_cast<uint16_t>(450 + (sample % 32))});
+            }
+            return length;
+        };
+
+        Benchmark("TelemetryCodec v1 frame (32 samples)", 1'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(EncodeFrame(false, i));
+            DoNotOptimize(frame);
+        });
+
+        Benchmark("TelemetryCodec v2 frame (32 samples)", 1'000'000, [&](const size_t & i)
+        {
+            DoNotOptimize(EncodeFrame(true, i));
+            DoNotOptimize(frame);
+        });
+
+        const auto length = EncodeFrame(true, 0);
+        Benchmark("TelemetryCodec v2 decode (32 samples)", 1'000'000, [&](const size_t &)
+        {
+            std::span<const uint8_t> buffer(frame.data(), length);
+            uint64_t base = 0;
+            auto offset = TelemetryCodec::DecodeMillisecondsHeader(buffer, base);
+            TelemetryCodec::Sample_t sample{};
+            int32_t sum = 0;
+            while ((offset > 0) && (offset < length))
+            {
+                const auto consumed = TelemetryCodec::DecodeSample(buffer.subspan(offset), sample);
+                offset = (consumed > 0) ? (offset + consumed) : 0;
+                sum += sample.temperature_x10;
+            }
+            DoNotOptimize(sum);
+        });
+
+        Benchmark("JSON v2 text (32 samples, baseline)", 1'000'000, [&](const size_t & i)
+        {
+            auto length = std::snprintf(text.data(), text.size(), "{\"v\":2,\"t0\":%lld,\"s\":[[0,%d,%u]",
+                                        static_cast<long long>(BASE_MILLISECONDS + i), 200, 450u);
+            for (size_t sample = 1; sample < SAMPLES; sample++)
+            {
+                length += std::snprintf(text.data() + length, text.size() - length, ",[%lld,%d,%u]",
+                                        static_cast<long long>(sample * 3001), static_cast<int>(200 + (sample % 16)),
+                                        static_cast<unsigned>(450 + (sample % 32)));
+            }
+            DoNotOptimize(length);
+            DoNotOptimize(text);
+        });
+    }
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    std::vector<std::string> fixtures;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--quick") == 0)
+        {
+            gs_TheIterationDivisor = 1000;
+        }
+        else
+        {
+            fixtures.emplace_back(argv[i]);
+        }
+    }
+
+    std::printf("%-40s %10s %18s\n", "Benchmark", "Iterations", "Mean");
+
+    for (const auto & path : fixtures)
+    {
+        EdgeFixture::Fixture_t fixture;
+        if (!EdgeFixture::Load(path, fixture))
+        {
+            return EXIT_FAILURE;
+        }
+        BenchmarkDecode(fixture);
+    }
+
+    BenchmarkChecksum();
+    BenchmarkDewPoint();
+    BenchmarkReadingFormatting();
+    BenchmarkTimestampFormatting();
+    BenchmarkPayloadEncoding();
+
+    return EXIT_SUCCESS;
+}
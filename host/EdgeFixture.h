@@ -0,0 +1,148 @@
+/***********************************************************************
+* @file      EdgeFixture.h
+*
+*    Loader of the recorded DHT11 bus captures under host/fixtures/.
+*
+* @brief   Each *.edges file is plain text: '#' comments, then
+*          "expect <key> <value>" lines for the replay harness, then one
+*          "<timestamp> <level>" pair per edge, in microseconds since the
+*          bus was released and the level of the bus after the edge.
+*          That is what the driver's edge capture records, and what
+*          HostShim::Bus plays back to busy-wait polling reads.
+*
+* @note    Expectation keys, all optional:
+*
+*          decode       SensorStatus_t name, of DecodeCapturedEdges()
+*          frame        the 40-bit frame it decodes, in hexadecimal
+*          checksum     valid or invalid
+*          sync         the response's high width, in microseconds
+*          polling      SensorStatus_t name, of a BUSY_WAIT_POLLING ReadData()
+*          humidity     %RH x10, of that read
+*          temperature  degrees Celsius x10, of that read
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <optional>
+#include <algorithm>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+namespace EdgeFixture
+{
+    struct Fixture_t
+    {
+        std::string                         name;
+        std::vector<HostShim::Bus::Edge_t>  edges;
+        std::map<std::string, std::string>  expectations;
+    };
+
+    inline std::optional<std::string> GetExpectation(const Fixture_t & fixture, const std::string & key)
+    {
+        const auto it = fixture.expectations.find(key);
+        if (it == fixture.expectations.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    inline bool Load(const std::string & path, Fixture_t & fixture)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::fprintf(stderr, "Error! Cannot open fixture \"%s\".\n", path.c_str());
+            return false;
+        }
+
+        const auto slash = path.find_last_of('/');
+        fixture.name = path.substr((slash == std::string::npos) ? 0 : (slash + 1));
+        fixture.edges.clear();
+        fixture.expectations.clear();
+
+        std::string line;
+        for (size_t number = 1; std::getline(file, line); number++)
+        {
+            if (line.empty() || (line[0] == '#'))
+            {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            std::string first;
+            fields >> first;
+
+            if (first == "expect")
+            {
+                std::string key;
+                std::string value;
+                if (!(fields >> key >> value))
+                {
+                    std::fprintf(stderr, "Error! %s:%zu: malformed expectation.\n", fixture.name.c_str(), number);
+                    return false;
+                }
+                fixture.expectations[key] = value;
+                continue;
+            }
+
+            unsigned long timestamp = 0;
+            unsigned level = 0;
+            if ((std::sscanf(line.c_str(), "%lu %u", &timestamp, &level) != 2) || (level > 1)
+                || (!fixture.edges.empty() && (timestamp < fixture.edges.back().timestamp)))
+            {
+                std::fprintf(stderr, "Error! %s:%zu: malformed edge.\n", fixture.name.c_str(), number);
+                return false;
+            }
+            fixture.edges.push_back({static_cast<uint32_t>(timestamp), static_cast<uint8_t>(level)});
+        }
+
+        return true;
+    }
+
+    // As the driver's ISRs would have recorded them; whatever is beyond
+    // EDGE_CAPTURE_MAXIMUM_EDGES is lost likewise.
+    template <typename Device>
+    uint8_t ToCapturedEdges(const Fixture_t & fixture, typename Device::CapturedEdges_t & edges)
+    {
+        const auto count = std::min<size_t>(fixture.edges.size(), Device::EDGE_CAPTURE_MAXIMUM_EDGES);
+        for (size_t i = 0; i < count; i++)
+        {
+            edges[i] = {static_cast<uint16_t>(fixture.edges[i].timestamp), fixture.edges[i].level};
+        }
+        return static_cast<uint8_t>(count);
+    }
+
+    inline std::optional<SensorStatus_t> ToSensorStatus(const std::string & name)
+    {
+        static const std::map<std::string, SensorStatus_t> s_TheStatuses{
+            {"SUCCESS",              SensorStatus_t::SUCCESS},
+            {"ERROR_BUS_BUSY",       SensorStatus_t::ERROR_BUS_BUSY},
+            {"ERROR_NOT_DETECTED",   SensorStatus_t::ERROR_NOT_DETECTED},
+            {"ERROR_ACK_TOO_LONG",   SensorStatus_t::ERROR_ACK_TOO_LONG},
+            {"ERROR_SYNC_TIMEOUT",   SensorStatus_t::ERROR_SYNC_TIMEOUT},
+            {"ERROR_DATA_TIMEOUT",   SensorStatus_t::ERROR_DATA_TIMEOUT},
+            {"ERROR_BAD_CHECKSUM",   SensorStatus_t::ERROR_BAD_CHECKSUM},
+            {"ERROR_TOO_FAST_READS", SensorStatus_t::ERROR_TOO_FAST_READS},
+            {"ERROR_QUEUE_FULL",     SensorStatus_t::ERROR_QUEUE_FULL}};
+
+        const auto it = s_TheStatuses.find(name);
+        if (it == s_TheStatuses.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+} // namespace EdgeFixture
@@ -0,0 +1,163 @@
+/***********************************************************************
+* @file      EdgeReplay.cpp
+*
+*    Replays recorded DHT11 bus captures through NuerteyDHT11Device on
+*    the host, and checks each against the expectations it carries.
+*
+* @brief   Every capture goes through both acquisition modes: its edges
+*          through DecodeCapturedEdges(), as the edge capture ISRs would
+*          have recorded them, and its waveform through a busy-wait 
+*          polling ReadData() off HostShim::Bus.
+*
+* @code
+*   edge_replay fixtures/clean.edges fixtures/noisy.edges ...
+* @endcode
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <inttypes.h>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+#include "EdgeFixture.h"
+
+// The whole driver is thereby compiled against the shims, not merely 
+// whatever the replay calls into.
+template class NuerteyDHT11Device<DHT11_t, PE_13>;
+
+using Sensor_t = NuerteyDHT11Device<DHT11_t, PE_13>;
+
+namespace
+{
+    class Checker
+    {
+    public:
+        explicit Checker(const std::string & name) : m_TheName(name) {}
+
+        template <typename T>
+        void Expect(const char * what, const T & actual, const T & expected, const std::string & text)
+        {
+            if (actual != expected)
+            {
+                std::fprintf(stderr, "Error! %s: %s is not %s.\n", m_TheName.c_str(), what, text.c_str());
+                ++m_TheFailureCount;
+            }
+        }
+
+        void Fail(const char * what, const std::string & text)
+        {
+            std::fprintf(stderr, "Error! %s: unexpected %s \"%s\".\n", m_TheName.c_str(), what, text.c_str());
+            ++m_TheFailureCount;
+        }
+
+        int GetFailureCount() const { return m_TheFailureCount; }
+
+    private:
+        std::string m_TheName;
+        int         m_TheFailureCount{0};
+    };
+
+    void ExpectStatus(Checker & checker, const EdgeFixture::Fixture_t & fixture, const char * key, const SensorStatus_t & actual)
+    {
+        const auto expected = EdgeFixture::GetExpectation(fixture, key);
+        if (!expected)
+        {
+            return;
+        }
+
+        const auto status = EdgeFixture::ToSensorStatus(*expected);
+        if (!status)
+        {
+            checker.Fail("status", *expected);
+            return;
+        }
+        checker.Expect(key, actual, *status, *expected);
+    }
+
+    void ReplayEdgeCapture(Checker & checker, const EdgeFixture::Fixture_t & fixture)
+    {
+        Sensor_t::CapturedEdges_t edges{};
+        const auto count = EdgeFixture::ToCapturedEdges<Sensor_t>(fixture, edges);
+
+        Sensor_t::DataFrame_t frame = 0;
+        Sensor_t::HealthMetrics_t metrics{};
+        const auto result = Sensor_t::DecodeCapturedEdges(edges, count, frame, Sensor_t::EDGE_CAPTURE_BIT_THRESHOLD_US, &metrics);
+
+        ExpectStatus(checker, fixture, "decode", result);
+
+        if (const auto expected = EdgeFixture::GetExpectation(fixture, "frame"))
+        {
+            checker.Expect("frame", frame, static_cast<Sensor_t::DataFrame_t>(std::strtoull(expected->c_str(), nullptr, 16)), *expected);
+        }
+
+        if (const auto expected = EdgeFixture::GetExpectation(fixture, "checksum"))
+        {
+            checker.Expect("checksum", Sensor_t::IsChecksumValid(frame), (*expected == "valid"), *expected);
+        }
+
+        if (const auto expected = EdgeFixture::GetExpectation(fixture, "sync"))
+        {
+            checker.Expect("sync", static_cast<unsigned long>(metrics.syncHighWidth), std::strtoul(expected->c_str(), nullptr, 10), *expected);
+        }
+    }
+
+    void ReplayPolling(Checker & checker, const EdgeFixture::Fixture_t & fixture)
+    {
+        HostShim::Bus::Instance().Load(fixture.edges);
+
+        Sensor_t sensor(AcquisitionMode_t::BUSY_WAIT_POLLING);
+        sensor.SetMaximumRetries(0);
+
+        const auto result = sensor.ReadData();
+        ExpectStatus(checker, fixture, "polling", ToEnum<SensorStatus_t>(result.value()));
+
+        const auto reading = sensor.GetLastReading();
+
+        if (const auto expected = EdgeFixture::GetExpectation(fixture, "humidity"))
+        {
+            checker.Expect("humidity", static_cast<long>(reading.humidity.GetTenths()), std::strtol(expected->c_str(), nullptr, 10), *expected);
+        }
+
+        if (const auto expected = EdgeFixture::GetExpectation(fixture, "temperature"))
+        {
+            checker.Expect("temperature", static_cast<long>(reading.temperature.GetTenths()), std::strtol(expected->c_str(), nullptr, 10), *expected);
+        }
+    }
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: %s <fixture.edges>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int failures = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        EdgeFixture::Fixture_t fixture;
+        if (!EdgeFixture::Load(argv[i], fixture))
+        {
+            ++failures;
+            continue;
+        }
+
+        Checker checker(fixture.name);
+        ReplayEdgeCapture(checker, fixture);
+        ReplayPolling(checker, fixture);
+
+        std::printf("%s: %zu edges, %s\n", fixture.name.c_str(), fixture.edges.size(),
+                    (checker.GetFailureCount() == 0) ? "passed" : "FAILED");
+        failures += checker.GetFailureCount();
+    }
+
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
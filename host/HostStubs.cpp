@@ -0,0 +1,41 @@
+/***********************************************************************
+* @file      HostStubs.cpp
+*
+*    Host definitions of what NuerteyMQTTClient.cpp links against but
+*    which, on target, comes with the rest of the application.
+*
+* @brief   Logging goes straight to stderr, as there is neither a UART
+*          to spare the caller from nor a writer thread to do it. JWT
+*          credentials are refused, as NuerteyMQTTClientJWT.cpp takes
+*          jwt-mbed and the NTP client, neither of which is built here.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 15, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include "NuerteyLogger.h"
+#include "NuerteyMQTTClient.h"
+
+namespace Logging
+{
+    void Start() {}
+    void Stop() { fflush(stderr); }
+    uint32_t GetDroppedCount() { return 0; }
+
+    namespace Detail
+    {
+        void Write(const char * format, va_list arguments)
+        {
+            vfprintf(stderr, format, arguments);
+        }
+    }
+} // namespace Logging
+
+bool NuerteyMQTTClient::RefreshJWTIfDue()
+{
+    LOG_ERROR("\r\nError! JWT credentials are not supported off-target.\n");
+    return false;
+}
@@ -0,0 +1,216 @@
+/***********************************************************************
+* @file      MQTTThroughput.cpp
+*
+*    End-to-end throughput of batched readings through NuerteyMQTTClient,
+*    against a local MQTT broker, e.g. mosquitto, or an in-process one.
+*
+* @brief   Batches readings into COMPACT_BINARY_MILLISECONDS frames of 32
+*          samples, published at QoS 1 by the very client that runs on
+*          target, over the TCPSocket shim. Reports batches and samples
+*          per second and the slowest turnaround between acknowledged
+*          batches. With --loopback, a scripted socket stands in for the
+*          broker, acknowledging everything at once, so as to measure the
+*          client itself and to smoke test it under ctest without one.
+*
+* @code
+*   mosquitto -p 1883 &
+*   mqtt_throughput [--quick] [127.0.0.1 [1883]]
+*   mqtt_throughput [--quick] --loopback
+* @endcode
+*
+* @note    Without a broker listening, exits with SKIPPED_RETURN_CODE,
+*          which ctest reports as skipped rather than failed.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include "TCPSocket.h"
+#include "MQTTPacket.h"
+#include "NuerteyMQTTClient.h"
+#include "NuerteyNetworkErrors.h"
+
+namespace
+{
+    constexpr int         SKIPPED_RETURN_CODE = 77;
+    constexpr size_t      BATCH_SAMPLES       = 32;
+    constexpr const char *TOPIC               = "/Nuertey/Host/Benchmark/Readings";
+
+    // Acknowledges whatever it is sent as a broker would, immediately.
+    class LoopbackSocket : public TCPSocket
+    {
+    public:
+        nsapi_size_or_error_t send(const void * data, nsapi_size_t size) override
+        {
+            const auto pData = static_cast<const unsigned char *>(data);
+            m_TheOutbound.insert(m_TheOutbound.end(), pData, pData + size);
+
+            int remaining = 0;
+            int offset = 0;
+            while ((offset = MQTTPacketShim::ReadHeader(m_TheOutbound.data(), static_cast<int>(m_TheOutbound.size()), remaining)) > 0)
+            {
+                Answer(m_TheOutbound.data(), offset, remaining);
+                m_TheOutbound.erase(m_TheOutbound.begin(), m_TheOutbound.begin() + offset + remaining);
+            }
+            return static_cast<nsapi_size_or_error_t>(size);
+        }
+
+        nsapi_size_or_error_t recv(void * data, nsapi_size_t size) override
+        {
+            if (m_TheInbound.empty())
+            {
+                return NSAPI_ERROR_WOULD_BLOCK;
+            }
+
+            const auto count = std::min<size_t>(size, m_TheInbound.size());
+            std::copy_n(m_TheInbound.begin(), count, static_cast<unsigned char *>(data));
+            m_TheInbound.erase(m_TheInbound.begin(), m_TheInbound.begin() + count);
+            return static_cast<nsapi_size_or_error_t>(count);
+        }
+
+        nsapi_error_t close() override { return NSAPI_ERROR_OK; }
+
+    private:
+        void Answer(const unsigned char * pPacket, const int & offset, const int & remaining)
+        {
+            const auto type = pPacket[0] >> 4;
+            if (type == CONNECT)
+            {
+                m_TheInbound.insert(m_TheInbound.end(), {CONNACK << 4, 2, 0, 0});
+            }
+            else if ((type == PUBLISH) && (((pPacket[0] >> 1) & 0x03) == 1))
+            {
+                // The packet identifier follows the topic.
+                const auto topicLength = MQTTPacketShim::ReadInteger(pPacket + offset);
+                if ((2 + topicLength + 2) <= remaining)
+                {
+                    const auto pId = pPacket + offset + 2 + topicLength;
+                    m_TheInbound.insert(m_TheInbound.end(), {PUBACK << 4, 2, pId[0], pId[1]});
+                }
+            }
+            else if (type == PINGREQ)
+            {
+                m_TheInbound.insert(m_TheInbound.end(), {PINGRESP << 4, 0});
+            }
+        }
+
+        std::vector<unsigned char> m_TheOutbound;
+        std::deque<unsigned char>  m_TheInbound;
+    };
+
+    size_t                                    g_AcknowledgedBatches = 0;
+    size_t                                    g_FailedBatches = 0;
+    std::chrono::steady_clock::time_point     g_LastAcknowledgement;
+    std::chrono::duration<double, std::micro> g_SlowestTurnaround{0};
+
+    void OnBatchCompleted(std::span<const CompactReading_t> readings, bool acknowledged)
+    {
+        if (!acknowledged)
+        {
+            g_FailedBatches++;
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        g_SlowestTurnaround = std::max(g_SlowestTurnaround, std::chrono::duration<double, std::micro>(now - g_LastAcknowledgement));
+        g_LastAcknowledgement = now;
+        g_AcknowledgedBatches += (readings.size() == BATCH_SAMPLES) ? 1 : 0;
+    }
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    size_t batches = 1000;
+    bool isLoopback = false;
+    std::vector<const char *> arguments;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--quick") == 0)
+        {
+            batches = 20;
+        }
+        else if (std::strcmp(argv[i], "--loopback") == 0)
+        {
+            isLoopback = true;
+        }
+        else
+        {
+            arguments.push_back(argv[i]);
+        }
+    }
+
+    const char * address = (arguments.size() > 0) ? arguments[0] : "127.0.0.1";
+    const auto port = static_cast<uint16_t>((arguments.size() > 1) ? std::atoi(arguments[1]) : 1883);
+
+    LoopbackSocket loopback;
+    TCPSocket socket;
+    TCPSocket * pSocket = &loopback;
+    if (!isLoopback)
+    {
+        if ((socket.open() != NSAPI_ERROR_OK) || (socket.connect(SocketAddress(address, port)) != NSAPI_ERROR_OK))
+        {
+            std::printf("Warning! No MQTT broker at %s:%u; skipping.\n", address, static_cast<unsigned>(port));
+            return SKIPPED_RETURN_CODE;
+        }
+        socket.set_timeout(BLOCKING_SOCKET_TIMEOUT_MILLISECONDS);
+        pSocket = &socket;
+    }
+
+    NuerteyMQTTClient client(pSocket, isLoopback ? "loopback" : address, port);
+    if (!client.Connect())
+    {
+        std::fprintf(stderr, "Error! The broker at %s:%u refused to connect.\n", address, static_cast<unsigned>(port));
+        return EXIT_FAILURE;
+    }
+
+    client.SetBatchCallback(OnBatchCompleted);
+    client.EnableBatching(TOPIC, BATCH_SAMPLES, std::chrono::hours(1), NuerteyMQTTClient::PayloadEncoding_t::COMPACT_BINARY_MILLISECONDS);
+
+    const auto start = std::chrono::steady_clock::now();
+    g_LastAcknowledgement = start;
+
+    int64_t timestamp = 1'760'000'000'123LL;
+    for (size_t sample = 0; (sample < (batches * BATCH_SAMPLES)) && client.IsConnected(); sample++)
+    {
+        const CompactReading_t reading{timestamp, static_cast<int16_t>(200 + (sample % 16)),
+                                       static_cast<uint16_t>(450 + (sample % 32)), SensorStatus_t::SUCCESS};
+
+        // Whilst the previous batch awaits its PUBACK, a full one is held.
+        while (!client.Batch(reading) && client.IsConnected())
+        {
+            client.ServiceInFlightPublishes(1);
+        }
+        timestamp += 3001;
+    }
+    client.WaitForInFlightPublishes();
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    client.DisableBatching();
+    client.Disconnect();
+
+    if ((g_AcknowledgedBatches != batches) || (g_FailedBatches > 0))
+    {
+        std::fprintf(stderr, "Error! [%zu] of [%zu] batches acknowledged, [%zu] failed.\n",
+                     g_AcknowledgedBatches, batches, g_FailedBatches);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%zu batches of %zu samples in %.3f s%s\n",
+                batches, BATCH_SAMPLES, elapsed.count(), isLoopback ? " (loopback)" : "");
+    std::printf("%.0f batches/s, %.0f samples/s; %.1f us per batch, slowest turnaround %.1f us\n",
+                static_cast<double>(batches) / elapsed.count(),
+                static_cast<double>(batches * BATCH_SAMPLES) / elapsed.count(),
+                (elapsed.count() * 1e6) / static_cast<double>(batches), g_SlowestTurnaround.count());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+/***********************************************************************
+* @file      TokenizerCheck.cpp
+*
+*    Checks JSON::Tokenize() on documents it must accept, and on those it
+*    must reject with the right error, then walks one accepted document's
+*    tokens as the configuration parser does.
+*
+* @code
+*   tokenizer_check
+* @endcode
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 15, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include "NuerteyJSONTokenizer.h"
+
+namespace
+{
+    struct Case_t
+    {
+        std::string_view text;
+        int              expected; // Token count, or else JSON::Error_t.
+    };
+
+    constexpr Case_t CASES[] =
+    {
+        // Accepted.
+        {"{}",                                             1},
+        {"[]",                                             1},
+        {" \"lone\" ",                                     1},
+        {"-12.5e3",                                        1},
+        {"{\"a\":1}",                                      3},
+        {"[true, false, null, -1.5E+3]",                   5},
+        {"{\"a\":[1,2,{\"b\":null}],\"c\":\"x\\\"y\"}",   10},
+        {"{\"s\":\"\\u00e9\\n\\/\"}",                      3},
+        {"\r\n\t{ \"a\" : [ ] }\r\n",                      3},
+
+        // Rejected.
+        {"",                                               JSON::INCOMPLETE},
+        {"{\"a\":1",                                       JSON::INCOMPLETE},
+        {"\"abc",                                          JSON::INCOMPLETE},
+        {"\"a\\u00",                                       JSON::INCOMPLETE},
+        {"{\"a\":",                                        JSON::INCOMPLETE},
+        {"{\"a\":1,}",                                     JSON::INVALID},
+        {"[1,]",                                           JSON::INVALID},
+        {"[,1]",                                           JSON::INVALID},
+        {"{\"a\" 1}",                                      JSON::INVALID},
+        {"{\"a\"::1}",                                     JSON::INVALID},
+        {"{1:2}",                                          JSON::INVALID},
+        {"[1 2]",                                          JSON::INVALID},
+        {"[1]]",                                           JSON::INVALID},
+        {"[1}",                                            JSON::INVALID},
+        {"{\"a\":1} 2",                                    JSON::INVALID},
+        {"{\"a\":tru}",                                    JSON::INVALID},
+        {"{\"a\":.5}",                                     JSON::INVALID},
+        {"{\"a\":\"\\x\"}",                                JSON::INVALID},
+        {"{\"a\":\"\\u12G4\"}",                            JSON::INVALID},
+        {"{\"a\":\"tab\there\"}",                          JSON::INVALID},
+        {"{'a':1}",                                        JSON::INVALID},
+    };
+
+    // As the firmware would, at compile time.
+    constexpr int TokenizeAtCompileTime(std::string_view text)
+    {
+        std::array<JSON::Token_t, 8> tokens{};
+        return JSON::Tokenize(text, tokens);
+    }
+
+    static_assert(TokenizeAtCompileTime("{\"period\":3000}") == 3);
+    static_assert(TokenizeAtCompileTime("{\"period\":}") == JSON::INVALID);
+
+    int CheckCases()
+    {
+        int failures = 0;
+        for (const auto & testCase : CASES)
+        {
+            std::array<JSON::Token_t, 16> tokens{};
+            const auto result = JSON::Tokenize(testCase.text, tokens);
+            if (result != testCase.expected)
+            {
+                std::fprintf(stderr, "Error! [%.*s] tokenized to %d, expected %d.\n",
+                             static_cast<int>(testCase.text.size()), testCase.text.data(), result, testCase.expected);
+                ++failures;
+            }
+        }
+
+        std::printf("cases: %zu, %s\n", std::size(CASES), (failures == 0) ? "passed" : "FAILED");
+        return failures;
+    }
+
+    int CheckTooManyTokens()
+    {
+        std::array<JSON::Token_t, 2> tokens{};
+        const auto result = JSON::Tokenize("[1,2]", tokens);
+        const bool isPassed = (result == JSON::TOO_MANY_TOKENS);
+        if (!isPassed)
+        {
+            std::fprintf(stderr, "Error! 3 tokens into 2 tokenized to %d, expected %d.\n", result, JSON::TOO_MANY_TOKENS);
+        }
+
+        std::printf("too many tokens: %s\n", isPassed ? "passed" : "FAILED");
+        return isPassed ? 0 : 1;
+    }
+
+    int CheckStructure()
+    {
+        constexpr std::string_view text = "{\"topics\":{\"t\":\"/a\",\"h\":\"/b\"},\"period\":3000,\"big\":70000,\"frac\":1.5}";
+
+        std::array<JSON::Token_t, 16> tokens{};
+        const auto count = JSON::Tokenize(text, tokens);
+
+        int failures = 0;
+        const auto Expect = [&failures](const bool & condition, const char * what)
+        {
+            if (!condition)
+            {
+                std::fprintf(stderr, "Error! Structure: %s.\n", what);
+                ++failures;
+            }
+        };
+
+        Expect(count == 13, "13 tokens");
+        if (count != 13)
+        {
+            return failures;
+        }
+
+        Expect((tokens[0].type == JSON::TokenType_t::OBJECT) && (tokens[0].size == 4) && (tokens[0].parent == -1),
+               "a top-level object of 4 members");
+        Expect((tokens[0].start == 0) && (tokens[0].end == text.size()), "the top-level object spanning the text");
+        Expect((JSON::View(text, tokens[1]) == "topics") && (tokens[1].parent == 0), "the key \"topics\"");
+        Expect((tokens[2].type == JSON::TokenType_t::OBJECT) && (tokens[2].size == 2) && (tokens[2].parent == 0),
+               "a nested object of 2 members");
+        Expect((JSON::View(text, tokens[4]) == "/a") && (tokens[4].parent == 2), "the nested value \"/a\"");
+
+        // Skipping "topics"' value lands on the next key.
+        const auto next = JSON::Skip(std::span<const JSON::Token_t>(tokens.data(), count), 2);
+        Expect((next == 7) && (JSON::View(text, tokens[next]) == "period"), "Skip() past the nested object");
+
+        uint16_t period = 0;
+        Expect(JSON::ToInteger(text, tokens[8], period) && (period == 3000), "\"period\" converting to 3000");
+
+        uint16_t big = 0;
+        Expect(!JSON::ToInteger(text, tokens[10], big), "\"big\" not converting to 16 bits");
+
+        int fraction = 0;
+        Expect(!JSON::ToInteger(text, tokens[12], fraction), "\"frac\" not converting to an integer");
+
+        int topic = 0;
+        Expect(!JSON::ToInteger(text, tokens[4], topic), "a string not converting to an integer");
+
+        std::printf("structure: %s\n", (failures == 0) ? "passed" : "FAILED");
+        return failures;
+    }
+} // namespace
+
+int main()
+{
+    int failures = 0;
+
+    failures += CheckCases();
+    failures += CheckTooManyTokens();
+    failures += CheckStructure();
+
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
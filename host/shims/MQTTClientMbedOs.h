@@ -0,0 +1,227 @@
+/***********************************************************************
+* @file      MQTTClientMbedOs.h
+*
+*    Host stand-in for mbed-mqtt's MQTTClient, over the TCPSocket shim.
+*
+* @brief   NuerteyMQTTClient only leaves CONNECT, blocking publishes and
+*          DISCONNECT to the Paho client; its pipelined publishes, pings
+*          and incoming messages go over the socket directly. Hence that
+*          is all that is provided here: connect(), publish() at QoS 0 or
+*          1, disconnect() and a yield() which discards what it receives.
+*          subscribe() and unsubscribe() fail, as there is no SUBSCRIBE
+*          serializer in the MQTTPacket.h stand-in.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 15, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "TCPSocket.h"
+#include "MQTTPacket.h"
+
+// As mbed_app.json configures mbed-mqtt.max-packet-size on target.
+#if !defined(MBED_CONF_MBED_MQTT_MAX_PACKET_SIZE)
+#define MBED_CONF_MBED_MQTT_MAX_PACKET_SIZE 1024
+#endif
+
+namespace MQTT
+{
+    enum QoS { QOS0, QOS1, QOS2 };
+
+    enum returnCode { BUFFER_OVERFLOW = -2, FAILURE = -1, SUCCESS = 0 };
+
+    struct Message
+    {
+        enum QoS       qos;
+        bool           retained;
+        bool           dup;
+        unsigned short id;
+        void *         payload;
+        size_t         payloadlen;
+    };
+
+    struct MessageData
+    {
+        MessageData(MQTTString & aTopicName, Message & aMessage) : message(aMessage), topicName(aTopicName) {}
+
+        Message &    message;
+        MQTTString & topicName;
+    };
+} // namespace MQTT
+
+class MQTTClient
+{
+public:
+    typedef void (*messageHandler)(MQTT::MessageData &);
+
+    static constexpr size_t BUFFER_SIZE = MBED_CONF_MBED_MQTT_MAX_PACKET_SIZE;
+
+    explicit MQTTClient(TCPSocket * pSocket) : m_pSocket(pSocket) {}
+
+    nsapi_error_t connect(MQTTPacket_connectData & options)
+    {
+        const auto length = MQTTSerialize_connect(m_TheBuffer.data(), m_TheBuffer.size(), &options);
+        if ((length <= 0) || !Send(length) || (Receive(BLOCKING_TIMEOUT_MS) <= 0))
+        {
+            return MQTT::FAILURE;
+        }
+
+        unsigned char sessionPresent = 0;
+        unsigned char returnCode = 0;
+        if ((MQTTDeserialize_connack(&sessionPresent, &returnCode, m_TheBuffer.data(), m_TheBuffer.size()) != 1)
+            || (returnCode != 0))
+        {
+            return (returnCode != 0) ? static_cast<nsapi_error_t>(returnCode) : static_cast<nsapi_error_t>(MQTT::FAILURE);
+        }
+
+        m_IsConnected = true;
+        return NSAPI_ERROR_OK;
+    }
+
+    // At QoS 1, blocks until the PUBACK.
+    int publish(const char * topicName, MQTT::Message & message)
+    {
+        if (!m_IsConnected || (message.qos == MQTT::QOS2))
+        {
+            return MQTT::FAILURE;
+        }
+
+        if (message.qos == MQTT::QOS1)
+        {
+            message.id = NextPacketId();
+        }
+
+        MQTTString topic = MQTTString_initializer;
+        topic.cstring = const_cast<char *>(topicName);
+
+        const auto length = MQTTSerialize_publish(m_TheBuffer.data(), m_TheBuffer.size(), message.dup, message.qos,
+                                                  message.retained, message.id, topic,
+                                                  static_cast<unsigned char *>(message.payload),
+                                                  static_cast<int>(message.payloadlen));
+        if ((length <= 0) || !Send(length))
+        {
+            return MQTT::FAILURE;
+        }
+
+        while (message.qos == MQTT::QOS1)
+        {
+            if (Receive(BLOCKING_TIMEOUT_MS) <= 0)
+            {
+                return MQTT::FAILURE;
+            }
+
+            unsigned char type = 0;
+            unsigned char dup = 0;
+            unsigned short packetId = 0;
+            if ((MQTTDeserialize_ack(&type, &dup, &packetId, m_TheBuffer.data(), m_TheBuffer.size()) == 1)
+                && (type == PUBACK) && (packetId == message.id))
+            {
+                break;
+            }
+        }
+
+        return MQTT::SUCCESS;
+    }
+
+    int subscribe(const char *, enum MQTT::QoS, messageHandler) { return MQTT::FAILURE; }
+    int unsubscribe(const char *) { return MQTT::FAILURE; }
+
+    int disconnect()
+    {
+        const auto length = MQTTSerialize_disconnect(m_TheBuffer.data(), m_TheBuffer.size());
+        const bool isSent = m_IsConnected && (length > 0) && Send(length);
+        m_IsConnected = false;
+        return isSent ? MQTT::SUCCESS : MQTT::FAILURE;
+    }
+
+    int yield(unsigned long timeout_ms = 1000L)
+    {
+        return (Receive(static_cast<int>(timeout_ms)) < 0) ? MQTT::FAILURE : MQTT::SUCCESS;
+    }
+
+    bool isConnected() const { return m_IsConnected; }
+
+private:
+    static constexpr int BLOCKING_TIMEOUT_MS = 5000;
+
+    unsigned short NextPacketId()
+    {
+        // Stay in the lower half, as NuerteyMQTTClient pipelines in the upper.
+        m_ThePacketId = (m_ThePacketId % 0x7FFF) + 1;
+        return m_ThePacketId;
+    }
+
+    bool Send(const int & length)
+    {
+        int sent = 0;
+        while (sent < length)
+        {
+            const auto rc = m_pSocket->send(m_TheBuffer.data() + sent, length - sent);
+            if (rc <= 0)
+            {
+                return false;
+            }
+            sent += rc;
+        }
+        return true;
+    }
+
+    // Reads one whole packet into m_TheBuffer, returning its length, 0 on
+    // timeout, or MQTT::FAILURE.
+    int Receive(const int & timeout)
+    {
+        m_pSocket->set_timeout(timeout);
+        auto rc = m_pSocket->recv(m_TheBuffer.data(), 1);
+        m_pSocket->set_timeout(-1);
+        if (rc == NSAPI_ERROR_WOULD_BLOCK)
+        {
+            return 0;
+        }
+        if (rc != 1)
+        {
+            return MQTT::FAILURE;
+        }
+
+        int length = 1;
+        int remaining = 0;
+        int multiplier = 1;
+        do
+        {
+            if ((length > 4) || (m_pSocket->recv(m_TheBuffer.data() + length, 1) != 1))
+            {
+                return MQTT::FAILURE;
+            }
+            remaining += (m_TheBuffer[length] & 0x7F) * multiplier;
+            multiplier *= 128;
+        }
+        while (m_TheBuffer[length++] & 0x80);
+
+        if ((length + remaining) > static_cast<int>(m_TheBuffer.size()))
+        {
+            return MQTT::FAILURE;
+        }
+
+        while (remaining > 0)
+        {
+            rc = m_pSocket->recv(m_TheBuffer.data() + length, remaining);
+            if (rc <= 0)
+            {
+                return MQTT::FAILURE;
+            }
+            length += rc;
+            remaining -= rc;
+        }
+
+        return length;
+    }
+
+    TCPSocket *                           m_pSocket;
+    std::array<unsigned char, BUFFER_SIZE> m_TheBuffer{};
+    unsigned short                        m_ThePacketId{0};
+    bool                                  m_IsConnected{false};
+};
@@ -0,0 +1,320 @@
+/***********************************************************************
+* @file      MQTTPacket.h
+*
+*    Host stand-in for the Paho embedded MQTTPacket library, as bundled
+*    with mbed-mqtt.
+*
+* @brief   Only the few serializers that NuerteyMQTTClient and the
+*          MQTTClient stand-in call, with Paho's signatures and return
+*          conventions: packet lengths, MQTTPACKET_BUFFER_TOO_SHORT, or 1
+*          once a packet has been deserialized, else 0. MQTT 3.1 and 3.1.1
+*          CONNECTs; neither wills nor QoS 2 flows.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+typedef struct
+{
+    int    len;
+    char * data;
+} MQTTLenString;
+
+typedef struct
+{
+    char *        cstring;
+    MQTTLenString lenstring;
+} MQTTString;
+
+#define MQTTString_initializer {NULL, {0, NULL}}
+
+typedef struct
+{
+    char           struct_id[4];
+    int            struct_version;
+    unsigned char  MQTTVersion;        // 3 for MQTT 3.1, 4 for MQTT 3.1.1.
+    MQTTString     clientID;
+    unsigned short keepAliveInterval;
+    unsigned char  cleansession;
+    unsigned char  willFlag;           // Not supported; must be 0.
+    MQTTString     username;
+    MQTTString     password;
+} MQTTPacket_connectData;
+
+#define MQTTPacket_connectData_initializer { {'M', 'Q', 'T', 'C'}, 0, 4, MQTTString_initializer, 60, 1, 0, \
+                                             MQTTString_initializer, MQTTString_initializer }
+
+enum errors
+{
+    MQTTPACKET_BUFFER_TOO_SHORT = -2,
+    MQTTPACKET_READ_ERROR       = -1,
+    MQTTPACKET_READ_COMPLETE
+};
+
+enum msgTypes
+{
+    CONNECT = 1, CONNACK, PUBLISH, PUBACK, PUBREC, PUBREL,
+    PUBCOMP, SUBSCRIBE, SUBACK, UNSUBSCRIBE, UNSUBACK,
+    PINGREQ, PINGRESP, DISCONNECT
+};
+
+namespace MQTTPacketShim
+{
+    inline int Length(const MQTTString & text)
+    {
+        return text.cstring ? static_cast<int>(strlen(text.cstring)) : text.lenstring.len;
+    }
+
+    inline bool IsPresent(const MQTTString & text)
+    {
+        return (text.cstring != nullptr) || (text.lenstring.data != nullptr);
+    }
+
+    class Writer
+    {
+    public:
+        Writer(unsigned char * buffer, const int & length) : m_pCursor(buffer), m_pEnd(buffer + length) {}
+
+        // The fixed header, i.e. the type and flags then the remaining
+        // length as a varint of up to 4 bytes.
+        bool Header(const unsigned char & typeAndFlags, int remaining)
+        {
+            if (!Byte(typeAndFlags))
+            {
+                return false;
+            }
+
+            do
+            {
+                auto encoded = static_cast<unsigned char>(remaining % 128);
+                remaining /= 128;
+                if (remaining > 0)
+                {
+                    encoded |= 0x80;
+                }
+                if (!Byte(encoded))
+                {
+                    return false;
+                }
+            }
+            while (remaining > 0);
+
+            return true;
+        }
+
+        bool Byte(const unsigned char & value)
+        {
+            if (m_pCursor >= m_pEnd)
+            {
+                return false;
+            }
+            *m_pCursor++ = value;
+            return true;
+        }
+
+        bool Integer(const unsigned short & value)
+        {
+            return Byte(static_cast<unsigned char>(value >> 8)) && Byte(static_cast<unsigned char>(value & 0xFF));
+        }
+
+        bool Bytes(const void * pData, const int & length)
+        {
+            if ((m_pEnd - m_pCursor) < length)
+            {
+                return false;
+            }
+            if (length > 0)
+            {
+                memcpy(m_pCursor, pData, static_cast<size_t>(length));
+            }
+            m_pCursor += length;
+            return true;
+        }
+
+        bool String(const MQTTString & text)
+        {
+            const auto length = Length(text);
+            return Integer(static_cast<unsigned short>(length))
+                && Bytes(text.cstring ? text.cstring : text.lenstring.data, length);
+        }
+
+        unsigned char * Cursor() const { return m_pCursor; }
+
+    private:
+        unsigned char * m_pCursor;
+        unsigned char * m_pEnd;
+    };
+
+    // Decodes the remaining length, returning the offset of the variable
+    // header, or 0 should the buffer not hold the whole packet.
+    inline int ReadHeader(const unsigned char * buffer, const int & length, int & remaining)
+    {
+        remaining = 0;
+        int multiplier = 1;
+        int offset = 1;
+        unsigned char encoded = 0;
+        do
+        {
+            if ((offset >= length) || (offset > 4))
+            {
+                return 0;
+            }
+            encoded = buffer[offset++];
+            remaining += (encoded & 0x7F) * multiplier;
+            multiplier *= 128;
+        }
+        while (encoded & 0x80);
+
+        return ((offset + remaining) <= length) ? offset : 0;
+    }
+
+    inline unsigned short ReadInteger(const unsigned char * pData)
+    {
+        return static_cast<unsigned short>((pData[0] << 8) | pData[1]);
+    }
+} // namespace MQTTPacketShim
+
+inline int MQTTstrlen(MQTTString text)
+{
+    return MQTTPacketShim::Length(text);
+}
+
+inline int MQTTSerialize_connect(unsigned char * buf, int buflen, MQTTPacket_connectData * options)
+{
+    const bool isVersion4 = (options->MQTTVersion == 4);
+    const MQTTString protocol = {const_cast<char *>(isVersion4 ? "MQTT" : "MQIsdp"), {0, nullptr}};
+
+    const bool hasUsername = MQTTPacketShim::IsPresent(options->username);
+    const bool hasPassword = MQTTPacketShim::IsPresent(options->password);
+
+    int remaining = (2 + MQTTstrlen(protocol)) + 1 + 1 + 2 + (2 + MQTTstrlen(options->clientID));
+    remaining += hasUsername ? (2 + MQTTstrlen(options->username)) : 0;
+    remaining += hasPassword ? (2 + MQTTstrlen(options->password)) : 0;
+
+    const auto flags = static_cast<unsigned char>((options->cleansession ? 0x02 : 0x00)
+                                                | (hasUsername ? 0x80 : 0x00) | (hasPassword ? 0x40 : 0x00));
+
+    MQTTPacketShim::Writer writer(buf, buflen);
+    const bool isWritten = writer.Header(CONNECT << 4, remaining)
+                        && writer.String(protocol)
+                        && writer.Byte(isVersion4 ? 4 : 3)
+                        && writer.Byte(flags)
+                        && writer.Integer(options->keepAliveInterval)
+                        && writer.String(options->clientID)
+                        && (!hasUsername || writer.String(options->username))
+                        && (!hasPassword || writer.String(options->password));
+
+    return isWritten ? static_cast<int>(writer.Cursor() - buf) : MQTTPACKET_BUFFER_TOO_SHORT;
+}
+
+inline int MQTTDeserialize_connack(unsigned char * sessionPresent, unsigned char * connack_rc, unsigned char * buf, int buflen)
+{
+    int remaining = 0;
+    const auto offset = MQTTPacketShim::ReadHeader(buf, buflen, remaining);
+    if ((offset == 0) || ((buf[0] >> 4) != CONNACK) || (remaining < 2))
+    {
+        return 0;
+    }
+
+    *sessionPresent = buf[offset] & 0x01;
+    *connack_rc = buf[offset + 1];
+    return 1;
+}
+
+inline int MQTTSerialize_publish(unsigned char * buf, int buflen, unsigned char dup, int qos, unsigned char retained,
+                                 unsigned short packetid, MQTTString topicName, unsigned char * payload, int payloadlen)
+{
+    const int remaining = (2 + MQTTstrlen(topicName)) + ((qos > 0) ? 2 : 0) + payloadlen;
+    const auto typeAndFlags = static_cast<unsigned char>((PUBLISH << 4) | ((dup & 0x01) << 3)
+                                                       | ((qos & 0x03) << 1) | (retained & 0x01));
+
+    MQTTPacketShim::Writer writer(buf, buflen);
+    const bool isWritten = writer.Header(typeAndFlags, remaining)
+                        && writer.String(topicName)
+                        && ((qos == 0) || writer.Integer(packetid))
+                        && writer.Bytes(payload, payloadlen);
+
+    return isWritten ? static_cast<int>(writer.Cursor() - buf) : MQTTPACKET_BUFFER_TOO_SHORT;
+}
+
+inline int MQTTDeserialize_publish(unsigned char * dup, int * qos, unsigned char * retained, unsigned short * packetid,
+                                   MQTTString * topicName, unsigned char ** payload, int * payloadlen,
+                                   unsigned char * buf, int len)
+{
+    int remaining = 0;
+    int offset = MQTTPacketShim::ReadHeader(buf, len, remaining);
+    if ((offset == 0) || ((buf[0] >> 4) != PUBLISH) || (remaining < 2))
+    {
+        return 0;
+    }
+
+    const int end = offset + remaining;
+    *dup = (buf[0] >> 3) & 0x01;
+    *qos = (buf[0] >> 1) & 0x03;
+    *retained = buf[0] & 0x01;
+
+    const int topicLength = MQTTPacketShim::ReadInteger(buf + offset);
+    offset += 2;
+    if ((offset + topicLength + ((*qos > 0) ? 2 : 0)) > end)
+    {
+        return 0;
+    }
+
+    topicName->cstring = nullptr;
+    topicName->lenstring.len = topicLength;
+    topicName->lenstring.data = reinterpret_cast<char *>(buf + offset);
+    offset += topicLength;
+
+    *packetid = 0;
+    if (*qos > 0)
+    {
+        *packetid = MQTTPacketShim::ReadInteger(buf + offset);
+        offset += 2;
+    }
+
+    *payload = buf + offset;
+    *payloadlen = end - offset;
+    return 1;
+}
+
+// PUBACK, PUBREC, PUBREL, PUBCOMP and UNSUBACK alike.
+inline int MQTTDeserialize_ack(unsigned char * packettype, unsigned char * dup, unsigned short * packetid,
+                               unsigned char * buf, int buflen)
+{
+    int remaining = 0;
+    const auto offset = MQTTPacketShim::ReadHeader(buf, buflen, remaining);
+    if ((offset == 0) || (remaining < 2))
+    {
+        return 0;
+    }
+
+    *packettype = buf[0] >> 4;
+    *dup = (buf[0] >> 3) & 0x01;
+    *packetid = MQTTPacketShim::ReadInteger(buf + offset);
+    return 1;
+}
+
+inline int MQTTSerialize_puback(unsigned char * buf, int buflen, unsigned short packetid)
+{
+    MQTTPacketShim::Writer writer(buf, buflen);
+    return (writer.Header(PUBACK << 4, 2) && writer.Integer(packetid)) ? 4 : MQTTPACKET_BUFFER_TOO_SHORT;
+}
+
+inline int MQTTSerialize_pingreq(unsigned char * buf, int buflen)
+{
+    MQTTPacketShim::Writer writer(buf, buflen);
+    return writer.Header(PINGREQ << 4, 0) ? 2 : MQTTPACKET_BUFFER_TOO_SHORT;
+}
+
+inline int MQTTSerialize_disconnect(unsigned char * buf, int buflen)
+{
+    MQTTPacketShim::Writer writer(buf, buflen);
+    return writer.Header(DISCONNECT << 4, 0) ? 2 : MQTTPACKET_BUFFER_TOO_SHORT;
+}
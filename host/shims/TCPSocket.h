@@ -0,0 +1,149 @@
+/***********************************************************************
+* @file      TCPSocket.h
+*
+*    Host stand-in for Mbed OS's TCPSocket, over POSIX sockets.
+*
+* @brief   Only open(), connect(), send(), recv(), set_timeout() and
+*          close() are provided, with Mbed's return conventions, i.e. byte
+*          counts or else NSAPI_ERROR_* codes. As on target, a timeout of
+*          0 makes the socket non-blocking. IPv4 dotted quads only; there
+*          is no DNS.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <string>
+#include <cerrno>
+#include <cstdint>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include "nsapi_types.h"
+
+class NetworkInterface;
+
+class SocketAddress
+{
+public:
+    SocketAddress(const char * address = nullptr, const uint16_t & port = 0)
+        : m_TheAddress(address ? address : "")
+        , m_ThePort(port)
+    {
+    }
+
+    bool set_ip_address(const char * address) { m_TheAddress = address ? address : ""; return true; }
+    void set_port(const uint16_t & port) { m_ThePort = port; }
+
+    const char * get_ip_address() const { return m_TheAddress.c_str(); }
+    uint16_t     get_port() const { return m_ThePort; }
+
+private:
+    std::string m_TheAddress;
+    uint16_t    m_ThePort;
+};
+
+class TCPSocket
+{
+public:
+    TCPSocket() = default;
+
+    TCPSocket(const TCPSocket&) = delete;
+    TCPSocket& operator=(const TCPSocket&) = delete;
+
+    virtual ~TCPSocket() { close(); }
+
+    // The network interface is the host's own; any argument is ignored.
+    nsapi_error_t open(NetworkInterface * = nullptr)
+    {
+        if (m_TheDescriptor >= 0)
+        {
+            return NSAPI_ERROR_PARAMETER;
+        }
+
+        m_TheDescriptor = ::socket(AF_INET, SOCK_STREAM, 0);
+        return (m_TheDescriptor >= 0) ? NSAPI_ERROR_OK : NSAPI_ERROR_NO_SOCKET;
+    }
+
+    nsapi_error_t connect(const SocketAddress & address)
+    {
+        if (m_TheDescriptor < 0)
+        {
+            return NSAPI_ERROR_NO_SOCKET;
+        }
+
+        sockaddr_in peer{};
+        peer.sin_family = AF_INET;
+        peer.sin_port = htons(address.get_port());
+        if (::inet_pton(AF_INET, address.get_ip_address(), &peer.sin_addr) != 1)
+        {
+            return NSAPI_ERROR_PARAMETER;
+        }
+
+        if (::connect(m_TheDescriptor, reinterpret_cast<const sockaddr *>(&peer), sizeof(peer)) != 0)
+        {
+            return NSAPI_ERROR_NO_CONNECTION;
+        }
+
+        // As lwIP is configured on target; small publishes go out at once.
+        const int isNoDelay = 1;
+        ::setsockopt(m_TheDescriptor, IPPROTO_TCP, TCP_NODELAY, &isNoDelay, sizeof(isNoDelay));
+        return NSAPI_ERROR_OK;
+    }
+
+    virtual nsapi_size_or_error_t send(const void * data, nsapi_size_t size)
+    {
+        const auto sent = ::send(m_TheDescriptor, data, size, MSG_NOSIGNAL | Flags());
+        return (sent >= 0) ? static_cast<nsapi_size_or_error_t>(sent) : ToError();
+    }
+
+    // 0 once the peer has closed the connection.
+    virtual nsapi_size_or_error_t recv(void * data, nsapi_size_t size)
+    {
+        const auto received = ::recv(m_TheDescriptor, data, size, Flags());
+        return (received >= 0) ? static_cast<nsapi_size_or_error_t>(received) : ToError();
+    }
+
+    // In milliseconds; negative blocks indefinitely, 0 not at all.
+    void set_timeout(int timeout)
+    {
+        m_TheTimeout = timeout;
+
+        timeval interval{};
+        if (timeout > 0)
+        {
+            interval.tv_sec = timeout / 1000;
+            interval.tv_usec = (timeout % 1000) * 1000;
+        }
+        ::setsockopt(m_TheDescriptor, SOL_SOCKET, SO_RCVTIMEO, &interval, sizeof(interval));
+        ::setsockopt(m_TheDescriptor, SOL_SOCKET, SO_SNDTIMEO, &interval, sizeof(interval));
+    }
+
+    virtual nsapi_error_t close()
+    {
+        if (m_TheDescriptor >= 0)
+        {
+            ::close(m_TheDescriptor);
+            m_TheDescriptor = -1;
+        }
+        return NSAPI_ERROR_OK;
+    }
+
+private:
+    int Flags() const { return (m_TheTimeout == 0) ? MSG_DONTWAIT : 0; }
+
+    nsapi_error_t ToError() const
+    {
+        return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? NSAPI_ERROR_WOULD_BLOCK : NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    int m_TheDescriptor{-1};
+    int m_TheTimeout{-1};
+};
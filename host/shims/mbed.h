@@ -0,0 +1,364 @@
+/***********************************************************************
+* @file      mbed.h
+*
+*    Host stand-ins for the few Mbed OS types that the sensor driver
+*    names, so that NuerteyDHT11Device.h builds on a workstation as is.
+*
+* @brief   Time is simulated rather than measured. wait_us(), sleep_for()
+*          and sleep_until() merely advance HostShim::Now(), whence the
+*          Timer, Kernel::Clock and the bus all read. A busy-wait read
+*          hence replays in a fraction of its 25ms, and deterministically.
+*
+*          DigitalInOut is wired to HostShim::Bus. Once the pin is switched
+*          to input, i.e. the bus is released, it reads back whichever
+*          waveform was loaded, relative to that instant; before its first
+*          edge, the pull-up keeps the bus high.
+*
+* @note    - MemoryPool hands out blocks as Mbed OS's does, but as
+*            they are default constructed up front, T must be too.
+*          - InterruptIn, Ticker, EventFlags and EventQueue only go as far
+*            as the driver compiles; nothing is ever dispatched, hence
+*            ReadDataAsync() and EDGE_CAPTURE reads do not complete here.
+*            Replay recorded edges through DecodeCapturedEdges() instead.
+*          - Single threaded, like the replay harness and the benchmarks.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+#include <chrono>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+using namespace std::chrono_literals;
+
+#define MBED_ASSERT(expression) do { if (!(expression)) { std::fprintf(stderr, "Error! MBED_ASSERT(%s) failed.\n", #expression); } } while (0)
+#define MBED_PRINTF(format_index, first_param_index) __attribute__((format(printf, format_index, first_param_index)))
+
+typedef enum
+{
+    PE_9  = 0x49,
+    PE_11 = 0x4B,
+    PE_13 = 0x4D,
+    PF_9  = 0x59,
+    PF_14 = 0x5E,
+    NC    = static_cast<int>(0xFFFFFFFF)
+} PinName;
+
+enum PinMode
+{
+    PullNone,
+    PullUp,
+    PullDown,
+    PullDefault = PullUp
+};
+
+namespace HostShim
+{
+    // Microseconds since start-up, in simulated time.
+    inline int64_t g_TheNow = 0;
+
+    inline int64_t Now() { return g_TheNow; }
+    inline void    Advance(const int64_t & microseconds) { g_TheNow += microseconds; }
+
+    class Bus
+    {
+    public:
+        struct Edge_t
+        {
+            uint32_t timestamp; // Microseconds since the bus was released.
+            uint8_t  level;     // Level of the bus *after* the edge.
+        };
+
+        static Bus & Instance()
+        {
+            static Bus s_TheBus;
+            return s_TheBus;
+        }
+
+        void Load(std::vector<Edge_t> waveform) { m_TheWaveform = std::move(waveform); }
+
+        void Release() { m_TheReleaseTime = Now(); m_IsReleased = true; }
+        void Drive(const int & level) { m_TheDrivenLevel = level; m_IsReleased = false; }
+
+        int Read() const
+        {
+            if (!m_IsReleased)
+            {
+                return m_TheDrivenLevel;
+            }
+
+            const auto elapsed = Now() - m_TheReleaseTime;
+            int level = 1;
+            for (const auto & edge : m_TheWaveform)
+            {
+                if (static_cast<int64_t>(edge.timestamp) > elapsed)
+                {
+                    break;
+                }
+                level = edge.level;
+            }
+            return level;
+        }
+
+    private:
+        std::vector<Edge_t> m_TheWaveform;
+        int64_t             m_TheReleaseTime{0};
+        int                 m_TheDrivenLevel{1};
+        bool                m_IsReleased{true};
+    };
+} // namespace HostShim
+
+inline void wait_us(int microseconds)
+{
+    HostShim::Advance(microseconds);
+}
+
+namespace mbed
+{
+    template <typename F>
+    class Callback;
+
+    template <typename R, typename... Args>
+    class Callback<R(Args...)>
+    {
+    public:
+        Callback() = default;
+        Callback(std::nullptr_t) {}
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Callback>>>
+        Callback(F f) : m_TheFunction(std::move(f)) {}
+
+        template <typename T, typename M>
+        Callback(T * pObject, M method)
+            : m_TheFunction([pObject, method](Args... args) { return (pObject->*method)(args...); }) {}
+
+        R operator()(Args... args) const { return m_TheFunction(args...); }
+        R call(Args... args) const { return m_TheFunction(args...); }
+
+        explicit operator bool() const { return static_cast<bool>(m_TheFunction); }
+
+    private:
+        std::function<R(Args...)> m_TheFunction;
+    };
+
+    template <typename T, typename R, typename... Args>
+    Callback<R(Args...)> callback(T * pObject, R (T::*method)(Args...))
+    {
+        return Callback<R(Args...)>(pObject, method);
+    }
+
+    template <typename T, typename R, typename... Args>
+    Callback<R(Args...)> callback(const T * pObject, R (T::*method)(Args...) const)
+    {
+        return Callback<R(Args...)>(pObject, method);
+    }
+
+    template <typename R, typename... Args>
+    Callback<R(Args...)> callback(R (*function)(Args...))
+    {
+        return Callback<R(Args...)>(function);
+    }
+
+    class DigitalInOut
+    {
+    public:
+        explicit DigitalInOut(PinName) {}
+
+        void output() { m_IsOutput = true; HostShim::Bus::Instance().Drive(m_TheLevel); }
+        void input()  { m_IsOutput = false; HostShim::Bus::Instance().Release(); }
+        void mode(PinMode) {}
+
+        void write(int value)
+        {
+            m_TheLevel = value;
+            if (m_IsOutput)
+            {
+                HostShim::Bus::Instance().Drive(value);
+            }
+        }
+
+        int read() { return HostShim::Bus::Instance().Read(); }
+
+        DigitalInOut & operator=(int value) { write(value); return *this; }
+        operator int() { return read(); }
+
+    private:
+        int  m_TheLevel{1};
+        bool m_IsOutput{false};
+    };
+
+    class InterruptIn
+    {
+    public:
+        explicit InterruptIn(PinName) {}
+
+        void rise(Callback<void()> onRise) { m_TheRise = onRise; }
+        void fall(Callback<void()> onFall) { m_TheFall = onFall; }
+
+    private:
+        Callback<void()> m_TheRise;
+        Callback<void()> m_TheFall;
+    };
+
+    class Timer
+    {
+    public:
+        void start() { if (!m_IsRunning) { m_TheStart = HostShim::Now() - m_TheElapsed; m_IsRunning = true; } }
+        void stop()  { m_TheElapsed = Elapsed(); m_IsRunning = false; }
+        void reset() { m_TheStart = HostShim::Now(); m_TheElapsed = 0; }
+
+        std::chrono::microseconds elapsed_time() const { return std::chrono::microseconds(Elapsed()); }
+
+    private:
+        int64_t Elapsed() const { return m_IsRunning ? (HostShim::Now() - m_TheStart) : m_TheElapsed; }
+
+        int64_t m_TheStart{0};
+        int64_t m_TheElapsed{0};
+        bool    m_IsRunning{false};
+    };
+
+    class Ticker
+    {
+    public:
+        void attach(Callback<void()> onTick, std::chrono::microseconds) { m_TheTick = onTick; }
+        void detach() { m_TheTick = nullptr; }
+
+    private:
+        Callback<void()> m_TheTick;
+    };
+} // namespace mbed
+
+using namespace mbed;
+
+namespace rtos
+{
+    namespace Kernel
+    {
+        struct Clock
+        {
+            using duration   = std::chrono::milliseconds;
+            using rep        = duration::rep;
+            using period     = duration::period;
+            using time_point = std::chrono::time_point<Clock>;
+            static constexpr bool is_steady = true;
+
+            static time_point now() { return time_point(duration(HostShim::Now() / 1000)); }
+        };
+    } // namespace Kernel
+
+    namespace ThisThread
+    {
+        inline void sleep_for(const Kernel::Clock::duration & duration)
+        {
+            HostShim::Advance(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+        }
+
+        inline void sleep_until(const Kernel::Clock::time_point & time)
+        {
+            sleep_for(std::max(time - Kernel::Clock::now(), Kernel::Clock::duration::zero()));
+        }
+    } // namespace ThisThread
+
+    class EventFlags
+    {
+    public:
+        uint32_t set(uint32_t flags) { return (m_TheFlags |= flags); }
+        uint32_t clear(uint32_t flags = 0x7FFFFFFF) { const auto previous = m_TheFlags; m_TheFlags &= ~flags; return previous; }
+        uint32_t get() const { return m_TheFlags; }
+
+        uint32_t wait_any_for(uint32_t flags, std::chrono::milliseconds timeout, bool clearFlags = true)
+        {
+            const auto set = m_TheFlags & flags;
+            if (!set)
+            {
+                ThisThread::sleep_for(timeout);
+            }
+            else if (clearFlags)
+            {
+                m_TheFlags &= ~set;
+            }
+            return set;
+        }
+
+    private:
+        uint32_t m_TheFlags{0};
+    };
+
+    template <typename T, uint32_t N>
+    class MemoryPool
+    {
+    public:
+        MemoryPool() { for (auto & isUsed : m_IsUsed) { isUsed = false; } }
+
+        T * try_alloc()
+        {
+            for (uint32_t i = 0; i < N; ++i)
+            {
+                if (!m_IsUsed[i])
+                {
+                    m_IsUsed[i] = true;
+                    return &m_TheBlocks[i];
+                }
+            }
+            return nullptr;
+        }
+
+        int free(T * pBlock)
+        {
+            const auto index = pBlock - m_TheBlocks;
+            if ((index < 0) || (index >= static_cast<std::ptrdiff_t>(N)))
+            {
+                return -1;
+            }
+            m_IsUsed[index] = false;
+            return 0;
+        }
+
+    private:
+        T    m_TheBlocks[N];
+        bool m_IsUsed[N];
+    };
+} // namespace rtos
+
+using namespace rtos;
+
+namespace events
+{
+    class EventQueue
+    {
+    public:
+        template <typename F, typename... Args>
+        int call(F &&, Args &&...) { return 0; }
+
+        template <typename Duration, typename F, typename... Args>
+        int call_in(Duration, F &&, Args &&...) { return 0; }
+
+        bool cancel(int) { return true; }
+    };
+} // namespace events
+
+using namespace events;
+
+inline EventQueue * mbed_event_queue()
+{
+    static EventQueue s_TheSharedQueue;
+    return &s_TheSharedQueue;
+}
+
+class CriticalSectionLock
+{
+public:
+    CriticalSectionLock() = default;
+};
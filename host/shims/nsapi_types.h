@@ -0,0 +1,44 @@
+/***********************************************************************
+* @file      nsapi_types.h
+*
+*    Host stand-in for Mbed OS's network stack types and error codes.
+*
+* @brief   The codes match Mbed OS 6's, so that NuerteyNetworkErrors.h
+*          describes them alike on the host.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 14, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+typedef int      nsapi_error_t;
+typedef unsigned nsapi_size_t;
+typedef int      nsapi_size_or_error_t;
+
+enum nsapi_error
+{
+    NSAPI_ERROR_OK                 =  0,
+    NSAPI_ERROR_WOULD_BLOCK        = -3001,
+    NSAPI_ERROR_UNSUPPORTED        = -3002,
+    NSAPI_ERROR_PARAMETER          = -3003,
+    NSAPI_ERROR_NO_CONNECTION      = -3004,
+    NSAPI_ERROR_NO_SOCKET          = -3005,
+    NSAPI_ERROR_NO_ADDRESS         = -3006,
+    NSAPI_ERROR_NO_MEMORY          = -3007,
+    NSAPI_ERROR_NO_SSID            = -3008,
+    NSAPI_ERROR_DNS_FAILURE        = -3009,
+    NSAPI_ERROR_DHCP_FAILURE       = -3010,
+    NSAPI_ERROR_AUTH_FAILURE       = -3011,
+    NSAPI_ERROR_DEVICE_ERROR       = -3012,
+    NSAPI_ERROR_IN_PROGRESS        = -3013,
+    NSAPI_ERROR_ALREADY            = -3014,
+    NSAPI_ERROR_IS_CONNECTED       = -3015,
+    NSAPI_ERROR_CONNECTION_LOST    = -3016,
+    NSAPI_ERROR_CONNECTION_TIMEOUT = -3017,
+    NSAPI_ERROR_ADDRESS_IN_USE     = -3018,
+    NSAPI_ERROR_TIMEOUT            = -3019,
+    NSAPI_ERROR_BUSY               = -3020
+};